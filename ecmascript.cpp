@@ -1,6 +1,7 @@
 #include "ecmascript.h"
 #include "core/engine.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "ecmascript_instance.h"
 #include "ecmascript_language.h"
 #include "scene/resources/resource_format_text.h"
@@ -259,6 +260,10 @@ RES ResourceFormatLoaderECMAScript::load(const String &p_path, const String &p_o
 	return script;
 }
 
+bool ResourceFormatLoaderECMAScript::exists(const String &p_path) const {
+	return ResourceFormatLoaderECMAScriptModule::has_bundled_module(p_path) || ResourceFormatLoader::exists(p_path);
+}
+
 void ResourceFormatLoaderECMAScript::get_recognized_extensions(List<String> *p_extensions) const {
 	p_extensions->push_front(EXT_JSCLASS);
 	p_extensions->push_front(EXT_JSCLASS_BYTECODE);
@@ -350,11 +355,115 @@ String ResourceFormatLoaderECMAScriptModule::get_resource_type(const String &p_p
 	return "";
 }
 
+bool ResourceFormatLoaderECMAScriptModule::exists(const String &p_path) const {
+	return has_bundled_module(p_path) || ResourceFormatLoader::exists(p_path);
+}
+
+Vector<uint8_t> ResourceFormatLoaderECMAScriptModule::bundle_data;
+HashMap<String, ResourceFormatLoaderECMAScriptModule::BundleEntry> ResourceFormatLoaderECMAScriptModule::bundle_index;
+
+Error ResourceFormatLoaderECMAScriptModule::load_bundle(const String &p_path) {
+	unload_bundle();
+	if (!FileAccess::exists(p_path)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+	Error err;
+	bundle_data = FileAccess::get_file_as_array(p_path, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Cannot load module bundle '" + p_path + "'.");
+
+	const uint8_t *ptr = bundle_data.ptr();
+	const uint32_t size = bundle_data.size();
+	ERR_FAIL_COND_V(size < 12 || decode_uint32(ptr) != ECMASCRIPT_BUNDLE_MAGIC || decode_uint32(ptr + 4) != ECMASCRIPT_BUNDLE_VERSION, ERR_FILE_UNRECOGNIZED);
+	const uint32_t count = decode_uint32(ptr + 8);
+	uint32_t pos = 12;
+	for (uint32_t i = 0; i < count; i++) {
+		ERR_FAIL_COND_V(pos + 4 > size, ERR_FILE_CORRUPT);
+		const uint32_t path_length = decode_uint32(ptr + pos);
+		pos += 4;
+		ERR_FAIL_COND_V(pos + path_length + 12 > size, ERR_FILE_CORRUPT);
+		String path;
+		path.parse_utf8(reinterpret_cast<const char *>(ptr + pos), path_length);
+		pos += path_length;
+		BundleEntry entry;
+		entry.offset = decode_uint32(ptr + pos);
+		entry.size = decode_uint32(ptr + pos + 4);
+		entry.hash = decode_uint32(ptr + pos + 8);
+		pos += 12;
+		ERR_FAIL_COND_V(entry.offset + entry.size > size, ERR_FILE_CORRUPT);
+		bundle_index.set(path, entry);
+	}
+	print_verbose(vformat("ECMAScript: %d modules loaded from bundle %s", count, p_path));
+	return OK;
+}
+
+void ResourceFormatLoaderECMAScriptModule::unload_bundle() {
+	bundle_index.clear();
+	bundle_data.clear();
+}
+
+bool ResourceFormatLoaderECMAScriptModule::get_bundled_bytecode(const String &p_path, Vector<uint8_t> &r_bytecode) {
+	const BundleEntry *entry = bundle_index.getptr(p_path);
+	if (!entry) return false;
+	r_bytecode.resize(entry->size);
+	copymem(r_bytecode.ptrw(), bundle_data.ptr() + entry->offset, entry->size);
+	return true;
+}
+
+const uint8_t *ResourceFormatLoaderECMAScriptModule::get_bundled_bytecode_ptr(const String &p_path, uint32_t *r_size, uint32_t *r_hash) {
+	const BundleEntry *entry = bundle_index.getptr(p_path);
+	if (!entry) return NULL;
+	*r_size = entry->size;
+	*r_hash = entry->hash;
+	return bundle_data.ptr() + entry->offset;
+}
+
+void ResourceFormatLoaderECMAScriptModule::write_bundle(const Map<String, Vector<uint8_t> > &p_modules, Vector<uint8_t> &r_data) {
+	Vector<CharString> paths;
+	uint32_t index_size = 12;
+	for (const Map<String, Vector<uint8_t> >::Element *E = p_modules.front(); E; E = E->next()) {
+		paths.push_back(E->key().utf8());
+		index_size += 4 + paths[paths.size() - 1].length() + 12;
+	}
+
+	uint32_t data_size = 0;
+	for (const Map<String, Vector<uint8_t> >::Element *E = p_modules.front(); E; E = E->next()) {
+		data_size += E->get().size();
+	}
+	r_data.resize(index_size + data_size);
+
+	uint8_t *ptr = r_data.ptrw();
+	encode_uint32(ECMASCRIPT_BUNDLE_MAGIC, ptr);
+	encode_uint32(ECMASCRIPT_BUNDLE_VERSION, ptr + 4);
+	encode_uint32(p_modules.size(), ptr + 8);
+	uint32_t pos = 12;
+	uint32_t offset = index_size;
+	int i = 0;
+	for (const Map<String, Vector<uint8_t> >::Element *E = p_modules.front(); E; E = E->next(), i++) {
+		const CharString &path = paths[i];
+		const Vector<uint8_t> &bytecode = E->get();
+		encode_uint32(path.length(), ptr + pos);
+		copymem(ptr + pos + 4, path.get_data(), path.length());
+		pos += 4 + path.length();
+		encode_uint32(offset, ptr + pos);
+		encode_uint32(bytecode.size(), ptr + pos + 4);
+		encode_uint32(hash_djb2_buffer(bytecode.ptr(), bytecode.size()), ptr + pos + 8);
+		pos += 12;
+		copymem(ptr + offset, bytecode.ptr(), bytecode.size());
+		offset += bytecode.size();
+	}
+}
+
 RES ResourceFormatLoaderECMAScriptModule::load_static(const String &p_path, const String &p_original_path, Error *r_error) {
 	Error err = ERR_FILE_CANT_OPEN;
 	Ref<ECMAScriptModule> module;
 	module.instance();
 	module->set_script_path(p_path);
+	Vector<uint8_t> bundled_bytecode;
+	if (get_bundled_bytecode(p_path, bundled_bytecode)) {
+		module->set_bytecode(bundled_bytecode);
+		if (r_error) *r_error = OK;
+		return module;
+	}
 	if (p_path.ends_with("." EXT_JSMODULE) || p_path.ends_with("." EXT_JSCLASS) || p_path.ends_with("." EXT_JSON)) {
 		String code = FileAccess::get_file_as_string(p_path, &err);
 		if (r_error) *r_error = err;
@@ -14,6 +14,12 @@
 #define EXT_JSMODULE_BYTECODE EXT_JSMODULE "b"
 #define EXT_JSMODULE_ENCRYPTED EXT_JSMODULE "e"
 #define EXT_JSON "json"
+#define ECMASCRIPT_BUNDLE_PATH "res://ecmascript.bundle"
+#define ECMASCRIPT_BUNDLE_MAGIC 0x4E42534A // "JSBN"
+#define ECMASCRIPT_BUNDLE_VERSION 2
+// Exported bytecode files start with a header carrying the hash computed at export time
+#define ECMASCRIPT_BYTECODE_MAGIC 0x424A4447 // "GDJB"
+#define ECMASCRIPT_BYTECODE_HEADER_SIZE 8
 
 class ECMAScript : public Script {
 	GDCLASS(ECMAScript, Script);
@@ -94,6 +100,7 @@ public:
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const;
 	virtual bool handles_type(const String &p_type) const;
 	virtual String get_resource_type(const String &p_path) const;
+	virtual bool exists(const String &p_path) const;
 };
 
 class ResourceFormatSaverECMAScript : public ResourceFormatSaver {
@@ -129,8 +136,27 @@ public:
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const;
 	virtual bool handles_type(const String &p_type) const;
 	virtual String get_resource_type(const String &p_path) const;
+	// Bundled modules are not exported as separate files
+	virtual bool exists(const String &p_path) const;
 
 	static RES load_static(const String &p_path, const String &p_original_path = "", Error *r_error = NULL);
+
+	// Module bytecode packed into one archive at export, read once and sliced on import
+	struct BundleEntry {
+		uint32_t offset;
+		uint32_t size;
+		uint32_t hash;
+	};
+	static Vector<uint8_t> bundle_data;
+	static HashMap<String, BundleEntry> bundle_index;
+
+	static Error load_bundle(const String &p_path = ECMASCRIPT_BUNDLE_PATH);
+	static void unload_bundle();
+	static bool get_bundled_bytecode(const String &p_path, Vector<uint8_t> &r_bytecode);
+	// The returned pointer stays valid until the bundle is unloaded
+	static const uint8_t *get_bundled_bytecode_ptr(const String &p_path, uint32_t *r_size, uint32_t *r_hash);
+	_FORCE_INLINE_ static bool has_bundled_module(const String &p_path) { return bundle_index.has(p_path); }
+	static void write_bundle(const Map<String, Vector<uint8_t> > &p_modules, Vector<uint8_t> &r_data);
 };
 
 class ResourceFormatSaverECMAScriptModule : public ResourceFormatSaver {
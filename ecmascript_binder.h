@@ -31,6 +31,8 @@ struct BasicECMAClassInfo {
 struct ECMAClassInfo : public BasicECMAClassInfo {
 	ECMAScriptGCHandler constructor;
 	ECMAScriptGCHandler prototype;
+	// Script methods resolved along the prototype chain, used to dispatch calls from engine
+	HashMap<StringName, ECMAMethodInfo> method_functions;
 };
 
 struct GlobalNumberConstant {
@@ -89,6 +91,7 @@ public:
 
 	virtual ECMAScriptGCHandler create_ecma_instance_for_godot_object(const ECMAClassInfo *p_class, Object *p_object) = 0;
 	virtual Variant call_method(const ECMAScriptGCHandler &p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error) = 0;
+	virtual Variant call(const ECMAScriptGCHandler &p_fuction, const ECMAScriptGCHandler &p_target, const Variant **p_args, int p_argcount, Variant::CallError &r_error) = 0;
 	virtual bool get_instance_property(const ECMAScriptGCHandler &p_object, const StringName &p_name, Variant &r_ret) = 0;
 	virtual bool set_instance_property(const ECMAScriptGCHandler &p_object, const StringName &p_name, const Variant &p_value) = 0;
 	virtual bool has_method(const ECMAScriptGCHandler &p_object, const StringName &p_name) = 0;
@@ -20,6 +20,7 @@ struct ECMAScriptGCHandler {
 		FLAG_REFERENCE = 1 << 4,
 		FLAG_SCRIPT_FINALIZED = 1 << 5,
 		FLAG_CONTEXT_TRANSFERABLE = 1 << 6,
+		FLAG_INLINE_STORAGE = 1 << 7,
 	};
 	Variant::Type type;
 	uint8_t flags;
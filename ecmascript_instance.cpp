@@ -17,6 +17,8 @@ void ECMAScriptInstance::get_method_list(List<MethodInfo> *p_list) const {
 
 bool ECMAScriptInstance::has_method(const StringName &p_method) const {
 	if (!binder || !ecma_object.ecma_object) return false;
+	// Methods added to the instance after the class was registered are only found on the object
+	if (ecma_class && ecma_class->method_functions.has(p_method)) return true;
 	return binder->has_method(ecma_object, p_method);
 }
 
@@ -54,6 +56,11 @@ Variant ECMAScriptInstance::call(const StringName &p_method, const Variant **p_a
 		r_error.error = Variant::CallError::CALL_ERROR_INSTANCE_IS_NULL;
 		ERR_FAIL_V(Variant());
 	}
+	if (ecma_class) {
+		if (const ECMAMethodInfo *method = ecma_class->method_functions.getptr(p_method)) {
+			return binder->call(*method, ecma_object, p_args, p_argcount, r_error);
+		}
+	}
 	return binder->call_method(ecma_object, p_method, p_args, p_argcount, r_error);
 }
 
@@ -2,6 +2,7 @@
 #include "core/class_db.h"
 #include "core/os/file_access.h"
 ECMAScriptLanguage *ECMAScriptLanguage::singleton = NULL;
+thread_local ECMAScriptBinder *ECMAScriptLanguage::pooled_thread_binder = NULL;
 
 void ECMAScriptLanguage::init() {
 	ERR_FAIL_NULL(main_binder);
@@ -306,9 +307,11 @@ ECMAScriptLanguage::ECMAScriptLanguage() {
 
 	ERR_FAIL_COND(singleton);
 	singleton = this;
+	QuickJSBinder::initialize_globals();
 	main_binder = memnew(QuickJSBinder);
 }
 
 ECMAScriptLanguage::~ECMAScriptLanguage() {
 	memdelete(main_binder);
+	QuickJSBinder::finalize_globals();
 }
@@ -20,6 +20,8 @@ private:
 	ECMAScriptBinder *main_binder;
 	int language_index;
 	HashMap<Thread::ID, ECMAScriptBinder *> thread_binder_map;
+	// Worker running on the calling pool thread, pool threads switch binders without writing the map
+	static thread_local ECMAScriptBinder *pooled_thread_binder;
 #ifdef TOOLS_ENABLED
 	Set<Ref<ECMAScript> > scripts;
 #endif
@@ -28,11 +30,16 @@ public:
 	_FORCE_INLINE_ static ECMAScriptLanguage *get_singleton() { return singleton; }
 	_FORCE_INLINE_ static ECMAScriptBinder *get_main_binder() { return singleton->main_binder; }
 	_FORCE_INLINE_ static ECMAScriptBinder *get_thread_binder(Thread::ID p_id) {
+		if (pooled_thread_binder && p_id == Thread::get_caller_id()) {
+			return pooled_thread_binder;
+		}
 		if (ECMAScriptBinder **ptr = singleton->thread_binder_map.getptr(p_id)) {
 			return *ptr;
 		}
 		return NULL;
 	}
+	_FORCE_INLINE_ static ECMAScriptBinder *get_pooled_thread_binder() { return pooled_thread_binder; }
+	_FORCE_INLINE_ static void set_pooled_thread_binder(ECMAScriptBinder *p_binder) { pooled_thread_binder = p_binder; }
 
 	_FORCE_INLINE_ virtual String get_name() const { return "JavaScript"; }
 	_FORCE_INLINE_ int get_language_index() const { return language_index; }
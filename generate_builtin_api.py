@@ -409,6 +409,61 @@ def parse_class(cls):
 		'class_name': class_name,
 	}))
 
+# Types MethodBind::ptrcall can be fed with without going through Variant
+PTRCALL_TYPES = {
+	'bool': 'BOOL',
+	'int': 'INT',
+	'float': 'REAL',
+	'String': 'STRING',
+	'Vector2': 'VECTOR2',
+	'Rect2': 'RECT2',
+	'Vector3': 'VECTOR3',
+	'Transform2D': 'TRANSFORM2D',
+	'Plane': 'PLANE',
+	'Quat': 'QUAT',
+	'AABB': 'AABB',
+	'Basis': 'BASIS',
+	'Transform': 'TRANSFORM',
+	'Color': 'COLOR',
+}
+
+def parse_method_signatures(cls):
+	class_name = cls.get('name')
+	signatures = []
+	for m in (cls.find("methods") if cls.find("methods") is not None else []):
+		qualifiers = m.get('qualifiers') or ''
+		if 'virtual' in qualifiers or 'vararg' in qualifiers:
+			continue
+		ret = m.find("return")
+		if ret is None or ret.get('type') == 'void':
+			return_type = 'NIL'
+		elif ret.get('enum') is not None or ret.get('type') not in PTRCALL_TYPES:
+			continue # enums are returned as 32 bit integers
+		else:
+			return_type = PTRCALL_TYPES[ret.get('type')]
+		arguments = sorted(m.iter('argument'), key=lambda arg: int(arg.get('index')))
+		if not all(arg.get('type') in PTRCALL_TYPES for arg in arguments):
+			continue
+		signatures.append({
+			'class': class_name,
+			'name': m.get('name'),
+			'return': return_type,
+			'arguments': [PTRCALL_TYPES[arg.get('type')] for arg in arguments],
+		})
+	return signatures
+
+def generate_method_signatures_json(DOCS_DIRS, OUTPUT_FILE):
+	signatures = []
+	for docs_dir in DOCS_DIRS:
+		for file in sorted(os.listdir(docs_dir)):
+			if not file.endswith('.xml'):
+				continue
+			cls = ET.parse(open(os.path.join(docs_dir, file), 'r')).getroot()
+			if cls.get('name') in BUILTIN_CLASSES:
+				continue
+			signatures += parse_method_signatures(cls)
+	json.dump(signatures, open(OUTPUT_FILE, 'w'), ensure_ascii=False, indent=2, sort_keys=True)
+
 def generate_api_json(MODULE_DIR):
 	DOCS_DIR = os.path.abspath(os.path.join(MODULE_DIR, "../../doc/classes"))
 	if not os.path.isdir(DOCS_DIR) and len(sys.argv) > 1:
@@ -421,6 +476,15 @@ def generate_api_json(MODULE_DIR):
 		data = tree.getroot()
 		classes.append(parse_class(data))
 	json.dump(classes, open(OUTPUT_FILE, 'w'), ensure_ascii=False, indent=2, sort_keys=True)
+
+	# argument types of engine and module classes for the ptrcall fast path of release builds
+	docs_dirs = [DOCS_DIR]
+	modules_dir = os.path.abspath(os.path.join(MODULE_DIR, ".."))
+	for module in sorted(os.listdir(modules_dir)):
+		module_docs = os.path.join(modules_dir, module, "doc_classes")
+		if os.path.isdir(module_docs):
+			docs_dirs.append(module_docs)
+	generate_method_signatures_json(docs_dirs, os.path.join(MODULE_DIR, "method_signatures.gen.json"))
 	
 if __name__ == "__main__":
 	generate_api_json()
@@ -0,0 +1,62 @@
+// Measures JS <-> Variant conversion of large arrays and dictionaries.
+// Copy this folder to a project as res://benchmarks and run the same project on two builds to compare them:
+//   godot --no-window -s res://benchmarks/variant_conversion.jsx
+// Pass --size=N (elements per container) and --iterations=N to change the load.
+
+function get_option(name, default_value) {
+	for (const arg of godot.OS.get_cmdline_args()) {
+		if (arg.startsWith(`--${name}=`)) {
+			return parseInt(arg.substring(name.length + 3));
+		}
+	}
+	return default_value;
+}
+
+// set_meta converts the value to a Variant and get_meta converts it back
+function round_trip(holder, name, value, iterations) {
+	const begin = godot.OS.get_ticks_usec();
+	for (let i = 0; i < iterations; i++) {
+		holder.set_meta('value', value);
+		holder.get_meta('value');
+	}
+	const elapsed = godot.OS.get_ticks_usec() - begin;
+	console.log(`${name}: ${(elapsed / iterations).toFixed(1)} us per round trip`);
+}
+
+export default class VariantConversion extends godot.SceneTree {
+
+	_initialize() {
+		const size = get_option('size', 10000);
+		const iterations = get_option('iterations', 100);
+
+		const integers = new Array(size);
+		const numbers = new Array(size);
+		const mixed = new Array(size);
+		const dictionary = {};
+		for (let i = 0; i < size; i++) {
+			integers[i] = i & 0xff;
+			numbers[i] = i * 0.5;
+			mixed[i] = i % 2 ? `item${i}` : i;
+			dictionary[`key${i}`] = i;
+		}
+
+		console.log(`${size} elements, ${iterations} iterations`);
+		const holder = new godot.Object();
+		round_trip(holder, 'integer array', integers, iterations);
+		round_trip(holder, 'number array', numbers, iterations);
+		round_trip(holder, 'mixed array', mixed, iterations);
+		round_trip(holder, 'dictionary', dictionary, iterations);
+
+		// Numeric arrays passed where a pool array is expected skip the intermediate Array
+		const begin = godot.OS.get_ticks_usec();
+		for (let i = 0; i < iterations; i++) {
+			godot.Marshalls.raw_to_base64(integers);
+		}
+		console.log(`integer array to PoolByteArray: ${((godot.OS.get_ticks_usec() - begin) / iterations).toFixed(1)} us per call`);
+		holder.free();
+	}
+
+	_idle(delta) {
+		return true;
+	}
+}
@@ -0,0 +1,60 @@
+// Measures the round trip latency of Worker messages.
+// Copy this folder to a project as res://benchmarks and run:
+//   godot --no-window -s res://benchmarks/worker_ping_pong.jsx
+// Pass --rounds=N and --payload=N (numbers per message) to change the load.
+
+function get_option(name, default_value) {
+	for (const arg of godot.OS.get_cmdline_args()) {
+		if (arg.startsWith(`--${name}=`)) {
+			return parseInt(arg.substring(name.length + 3));
+		}
+	}
+	return default_value;
+}
+
+export default class WorkerPingPong extends godot.SceneTree {
+
+	_initialize() {
+		this.rounds = get_option('rounds', 10000);
+		this.payload = new Array(get_option('payload', 0)).fill(0);
+		this.received = 0;
+		this.done = false;
+		this.min_usec = Number.MAX_SAFE_INTEGER;
+		this.max_usec = 0;
+
+		this.worker = new Worker('res://benchmarks/worker_ping_pong_worker.js');
+		this.worker.onmessage = () => {
+			const rtt = godot.OS.get_ticks_usec() - this.sent_at;
+			this.min_usec = Math.min(this.min_usec, rtt);
+			this.max_usec = Math.max(this.max_usec, rtt);
+			if (++this.received < this.rounds) {
+				this.ping();
+			} else {
+				this.report();
+			}
+		};
+		this.begin = godot.OS.get_ticks_usec();
+		this.ping();
+	}
+
+	ping() {
+		this.sent_at = godot.OS.get_ticks_usec();
+		this.worker.postMessage({ seq: this.received, payload: this.payload });
+	}
+
+	report() {
+		const total = godot.OS.get_ticks_usec() - this.begin;
+		const stats = this.worker.getStats();
+		console.log(`${this.rounds} round trips with ${this.payload.length} numbers in ${(total / 1000).toFixed(1)} ms`);
+		console.log(`round trip: avg ${(total / this.rounds).toFixed(1)} us, min ${this.min_usec} us, max ${this.max_usec} us`);
+		console.log(`to worker:   queue latency avg ${stats.input.latency_avg_usec} us, max ${stats.input.latency_max_usec} us, dropped ${stats.input.dropped}`);
+		console.log(`from worker: queue latency avg ${stats.output.latency_avg_usec} us, max ${stats.output.latency_max_usec} us, dropped ${stats.output.dropped}`);
+		console.log(`scheduler:   ${stats.scheduler.wakeups} wakeups, latency avg ${stats.scheduler.latency_avg_usec} us, max ${stats.scheduler.latency_max_usec} us`);
+		this.worker.terminate();
+		this.done = true;
+	}
+
+	_idle(delta) {
+		return this.done;
+	}
+}
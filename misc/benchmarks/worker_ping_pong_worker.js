@@ -0,0 +1,4 @@
+// Echoes every message back to the host, see worker_ping_pong.jsx
+onmessage = function (message) {
+	postMessage(message);
+};
@@ -18,6 +18,28 @@ declare module globalThis {
 	 * @param request_id The ID value returned by the call to `godot.requestAnimationFrame()` that requested the callback.
 	 */
 	function cancelAnimationFrame(request_id: FrameRequetID): void;
+
+	/**
+	 * Calls `callback` with `args` once `delay` milliseconds have passed.
+	 * Expired timers fire at the start of the next frame, and the `JavaScript/timers/frame_budget_usec` project setting limits how long they may run each frame.
+	 * @returns The timer ID to pass to `clearTimeout()`
+	 */
+	function setTimeout(callback: (...args: any[]) => void, delay?: number, ...args: any[]): number;
+
+	/**
+	 * Calls `callback` with `args` every `delay` milliseconds, at most once per frame
+	 * @returns The timer ID to pass to `clearInterval()`
+	 */
+	function setInterval(callback: (...args: any[]) => void, delay?: number, ...args: any[]): number;
+
+	/** Cancels a timer created by `setTimeout()` */
+	function clearTimeout(id: number): void;
+
+	/** Cancels a timer created by `setInterval()` */
+	function clearInterval(id: number): void;
+
+	/** Queues `callback` to run with the pending promise jobs */
+	function queueMicrotask(callback: () => void): void;
 	
 	/**
 	 * The Console API provides functionality to allow developers to perform debugging tasks, such as logging messages or the values of variables at set points in your code, or timing how long an operation takes to complete.
@@ -62,19 +84,53 @@ declare module globalThis {
 	 *
 	 * You can **transfer** value with `Worker.abandonValue` and `Worker.adoptValue`. After a value is abandoned you cannot using it anymore in the context.
 	 *
+	 * ArrayBuffers and pool arrays listed in the `transfer` argument of `postMessage` are moved to the receiver and become empty in the sender.
+	 * Transferred buffers are moved without copying, including buffers of pool arrays (`get_buffer`, `as_typed_array`). Buffers backed by other native memory are copied once.
+	 *
+	 * A `SharedArrayBuffer` in a message is shared instead of copied, both sides view the same memory.
+	 * Workers share a fixed pool of threads, so `Atomics.wait` throws in workers as it does on the main thread. Synchronize with messages or by polling with `Atomics.load` instead.
+	 * Terminating a worker interrupts the script it is running.
+	 *
 	 * Workers may, in turn, spawn new workers, all sub-worker will be stopped when the host context stop.
 	 */
+	interface WorkerQueueStats {
+		capacity: number;
+		queued: number;
+		/** Most messages that were queued at once */
+		peak: number;
+		posted: number;
+		delivered: number;
+		dropped: number;
+		/** Times `postMessage` had to wait for room */
+		blocked: number;
+		/** Time from posting a message to its delivery in microseconds */
+		latency_avg_usec: number;
+		latency_max_usec: number;
+	}
+
+	interface WorkerSchedulerStats {
+		/** Times the worker was woken up by a message, a pending job, a due timer or a host frame */
+		wakeups: number;
+		/** Time from waking up to running on a pool thread in microseconds */
+		latency_avg_usec: number;
+		latency_max_usec: number;
+	}
+
 	//@ts-ignore
 	class Worker {
 		
 		/**
 		 * Creates a dedicated worker thread that executes the script at the specified file
+		 * @param options.highWaterMark Capacity of each message queue, defaults to the `JavaScript/worker/message_queue_capacity` project setting
+		 * @param options.overflow What the worker's `postMessage` does when the queue to the host is full, `block` waits for room and `drop` discards the message.
+		 * Messages posted to the worker are always dropped when its queue is full.
 		 */
-		constructor(script: string);
+		constructor(script: string, options?: { highWaterMark?: number, overflow?: 'block' | 'drop' });
 		
 		/**
 		 * The `onmessage` property of the Worker interface represents an event handler, that is a function to be called when the message event occurs.
 		 * It will be called when the worker's parent receives a message from the worker context by `postMessage` method.
+		 * Messages that arrive while it is not a function are discarded and counted as dropped.
 		 */
 		onmessage(message: any): void;
 		
@@ -82,8 +138,15 @@ declare module globalThis {
 		 * Sends a message to the worker's inner scope. This accepts a single parameter, which is the data to send to the worker.
 		 * @param message The object to deliver to the worker; this will be in the data field in the event delivered to the `onmessage` handler.
 		 * @note The data cannot be instance of `godot.Object` or any other JavaScript object conains functions.
+		 * @param transfer ArrayBuffers and pool arrays to move to the worker instead of copying
+		 * @returns `false` if the message was dropped because the queue was full
+		 */
+		postMessage(message: any, transfer?: (ArrayBuffer | PoolByteArray | PoolIntArray | PoolRealArray | PoolStringArray | PoolVector2Array | PoolVector3Array | PoolColorArray)[]): boolean;
+		
+		/**
+		 * Message counters of the queue to the worker (`input`) and the queue from it (`output`), and wake up counters of the worker
 		 */
-		postMessage(message: any): void;
+		getStats(): { input: WorkerQueueStats, output: WorkerQueueStats, scheduler: WorkerSchedulerStats };
 		
 		/**
 		 * Stop the worker thread
@@ -109,8 +172,10 @@ declare module globalThis {
 	 * Sends a message to the host thread context that spawned it.
 	 *
 	 * @param {*} message The message to send
+	 * @param transfer ArrayBuffers and pool arrays to move to the host instead of copying
+	 * @returns `false` if the message was dropped because the queue was full
 	 */
-	function postMessage(message: any): void;
+	function postMessage(message: any, transfer?: (ArrayBuffer | PoolByteArray | PoolIntArray | PoolRealArray | PoolStringArray | PoolVector2Array | PoolVector3Array | PoolColorArray)[]): boolean;
 	
 	/** **Worker context only**
 	 * 
@@ -216,6 +281,28 @@ declare module godot {
 	*/
 	function adopt_value(value_id: number): any;
 	
+	/**
+	 * Limit the promise jobs run each frame of the current context, the remaining jobs run in the next frame.
+	 * The defaults come from the `JavaScript/jobs/frame_budget_usec` and `JavaScript/jobs/max_jobs_per_frame` project settings.
+	 * @param budget_usec Time the jobs may take each frame in microseconds, `0` for no limit
+	 * @param max_jobs Number of jobs run each frame, `0` for no limit
+	 */
+	function set_job_budget(budget_usec: number, max_jobs?: number): void;
+	
+	/**
+	 * Promise job counters of the current context
+	 */
+	function get_job_stats(): {
+		budget_usec: number;
+		max_jobs: number;
+		jobs_run: number;
+		/** Jobs carried over to the next frame because the budget ran out, a job deferred over several frames is counted once */
+		jobs_deferred: number;
+		frames_deferred: number;
+		time_usec: number;
+		max_frame_time_usec: number;
+	};
+	
 	/**
 	 * Wait a signal of an object
 	 * @param target The owner of the signal to wait
@@ -1892,6 +1979,7 @@ declare module godot {
 		constructor(from: PoolByteArray);
 		constructor(from: ArrayBuffer);
 		constructor(from: DataView);
+		constructor(from: ArrayBufferView);
 		[Symbol.iterator](): IterableIterator<number>;
 		
 		/** Appends an element at the end of the array (alias of `push_back`). */
@@ -1947,6 +2035,12 @@ declare module godot {
 		
 		/** Returns the content of the array as an `ArrayBuffer` */
 		get_buffer() : ArrayBuffer;
+
+		/** Returns a `Uint8Array` viewing the memory of the array without copying it. Writes to the view change the array until the array is resized or modified through its own methods, which gives the array its own copy of the memory. */
+		as_typed_array() : Uint8Array;
+
+		/** Replaces the content of the array with the bytes of a TypedArray, a `DataView` or an `ArrayBuffer`. */
+		from_typed_array(source: ArrayBufferView | ArrayBuffer) : void;
 	}
 
 	/** A pooled `Array` of `Color`.
@@ -1960,6 +2054,7 @@ declare module godot {
 		constructor(from: PoolColorArray);
 		constructor(from: ArrayBuffer);
 		constructor(from: DataView);
+		constructor(from: ArrayBufferView);
 		[Symbol.iterator](): IterableIterator<Color>;
 
 		/** Appends an element at the end of the array (alias of `push_back`). */
@@ -1997,6 +2092,12 @@ declare module godot {
 
 		/** Returns the content of the array as an `ArrayBuffer` */
 		get_buffer() : ArrayBuffer;
+
+		/** Returns a `Float32Array` viewing the memory of the array without copying it. Writes to the view change the array until the array is resized or modified through its own methods, which gives the array its own copy of the memory. */
+		as_typed_array() : Float32Array;
+
+		/** Replaces the content of the array with the bytes of a TypedArray, a `DataView` or an `ArrayBuffer`. */
+		from_typed_array(source: ArrayBufferView | ArrayBuffer) : void;
 	}
 
 	/** A pooled `Array` of integers (`int`).
@@ -2012,6 +2113,7 @@ declare module godot {
 		constructor(from: PoolIntArray);
 		constructor(from: ArrayBuffer);
 		constructor(from: DataView);
+		constructor(from: ArrayBufferView);
 		[Symbol.iterator](): IterableIterator<number>;
 
 		/** Appends an element at the end of the array (alias of `push_back`). */
@@ -2049,6 +2151,12 @@ declare module godot {
 
 		/** Returns the content of the array as an `ArrayBuffer` */
 		get_buffer() : ArrayBuffer;
+
+		/** Returns a `Int32Array` viewing the memory of the array without copying it. Writes to the view change the array until the array is resized or modified through its own methods, which gives the array its own copy of the memory. */
+		as_typed_array() : Int32Array;
+
+		/** Replaces the content of the array with the bytes of a TypedArray, a `DataView` or an `ArrayBuffer`. */
+		from_typed_array(source: ArrayBufferView | ArrayBuffer) : void;
 	}
 
 	/** A pooled `Array` of reals (`float`).
@@ -2061,6 +2169,7 @@ declare module godot {
 		constructor(from: PoolRealArray);
 		constructor(from: ArrayBuffer);
 		constructor(from: DataView);
+		constructor(from: ArrayBufferView);
 		[Symbol.iterator](): IterableIterator<number>;
 
 		/** Appends an element at the end of the array (alias of `push_back`). */
@@ -2098,6 +2207,12 @@ declare module godot {
 
 		/** Returns the content of the array as an `ArrayBuffer` */
 		get_buffer() : ArrayBuffer;
+
+		/** Returns a `Float32Array` viewing the memory of the array without copying it. Writes to the view change the array until the array is resized or modified through its own methods, which gives the array its own copy of the memory. */
+		as_typed_array() : Float32Array;
+
+		/** Replaces the content of the array with the bytes of a TypedArray, a `DataView` or an `ArrayBuffer`. */
+		from_typed_array(source: ArrayBufferView | ArrayBuffer) : void;
 	}
 
 	/** A pooled `Array` of `String`.
@@ -2158,6 +2273,7 @@ declare module godot {
 		constructor(from: PoolVector2Array);
 		constructor(from: ArrayBuffer);
 		constructor(from: DataView);
+		constructor(from: ArrayBufferView);
 		[Symbol.iterator](): IterableIterator<Vector2>;
 
 		/** Appends an element at the end of the array (alias of `push_back`). */
@@ -2195,6 +2311,12 @@ declare module godot {
 		
 		/** Returns the content of the array as an `ArrayBuffer` */
 		get_buffer() : ArrayBuffer;
+
+		/** Returns a `Float32Array` viewing the memory of the array without copying it. Writes to the view change the array until the array is resized or modified through its own methods, which gives the array its own copy of the memory. */
+		as_typed_array() : Float32Array;
+
+		/** Replaces the content of the array with the bytes of a TypedArray, a `DataView` or an `ArrayBuffer`. */
+		from_typed_array(source: ArrayBufferView | ArrayBuffer) : void;
 	}
 
 	/** A pooled `Array` of `Vector3`.
@@ -2207,6 +2329,7 @@ declare module godot {
 		constructor(from: PoolVector3Array);
 		constructor(from: ArrayBuffer);
 		constructor(from: DataView);
+		constructor(from: ArrayBufferView);
 		[Symbol.iterator](): IterableIterator<Vector3>;
 
 		/** Appends an element at the end of the array (alias of `push_back`). */
@@ -2244,5 +2367,11 @@ declare module godot {
 		
 		/** Returns the content of the array as an `ArrayBuffer` */
 		get_buffer() : ArrayBuffer;
+
+		/** Returns a `Float32Array` viewing the memory of the array without copying it. Writes to the view change the array until the array is resized or modified through its own methods, which gives the array its own copy of the memory. */
+		as_typed_array() : Float32Array;
+
+		/** Replaces the content of the array with the bytes of a TypedArray, a `DataView` or an `ArrayBuffer`. */
+		from_typed_array(source: ArrayBufferView | ArrayBuffer) : void;
 	}
 }
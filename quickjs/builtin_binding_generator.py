@@ -118,11 +118,9 @@ static JSValue ${func}(JSContext *ctx, JSValueConst new_target, int argc, JSValu
 	${class} tmp;
 	${initializer}
 	JSValue proto = JS_GetProperty(ctx, new_target, QuickJSBinder::JS_ATOM_prototype);
-	JSValue obj = JS_NewObjectProtoClass(ctx, proto, QuickJSBinder::get_context_binder(ctx)->get_origin_class_id());
-	QuickJSBuiltinBinder::bind_builtin_object(ctx, obj, ${type}, &tmp);
+	JSValue obj = QuickJSBuiltinBinder::new_builtin_object(ctx, proto, ${type}, &tmp);
 	JS_FreeValue(ctx, proto);
 	return obj;
-	// return QuickJSBuiltinBinder::create_builtin_value(ctx, ${type}, &tmp);
 }
 '''
 	TemplateSimplePoolArrays = '''
@@ -137,8 +135,10 @@ static JSValue ${func}(JSContext *ctx, JSValueConst new_target, int argc, JSValu
 	TemplatePoolArrays = '''
 	if (argc == 1) {
 		if (JS_IsArray(ctx, argv[0])) {
-			Variant arr = QuickJSBinder::var_to_variant(ctx, argv[0]);
-			tmp.operator=(arr);
+			if (!QuickJSBinder::js_array_to_pool_array(ctx, argv[0], tmp)) {
+				Variant arr = QuickJSBinder::var_to_variant(ctx, argv[0]);
+				tmp.operator=(arr);
+			}
 		} else if (JS_IsArrayBuffer(argv[0])) {
 			size_t size;
 			uint8_t *buffer = JS_GetArrayBuffer(ctx, &size, argv[0]);
@@ -149,6 +149,17 @@ static JSValue ${func}(JSContext *ctx, JSValueConst new_target, int argc, JSValu
 				tmp.resize(size / sizeof(${element}));
 				copymem(tmp.write().ptr(), buffer, size / sizeof(${element}) * sizeof(${element}));
 			}
+		} else if (JS_IsTypedArray(argv[0])) {
+			size_t offset = 0;
+			size_t length = 0;
+			JSValue arraybuffer = JS_GetTypedArrayBuffer(ctx, argv[0], &offset, &length, NULL);
+			size_t size;
+			uint8_t *buffer = JS_IsException(arraybuffer) ? NULL : JS_GetArrayBuffer(ctx, &size, arraybuffer);
+			JS_FreeValue(ctx, arraybuffer);
+			if (buffer && length) {
+				tmp.resize(length / sizeof(${element}));
+				copymem(tmp.write().ptr(), buffer + offset, length / sizeof(${element}) * sizeof(${element}));
+			}
 		} else if (JS_IsDataView(argv[0])) {
 			JSValue byte_length = JS_GetPropertyStr(ctx, argv[0], "byteLength");
 			uint64_t length = QuickJSBinder::js_to_uint64(ctx, byte_length);
@@ -168,7 +179,7 @@ static JSValue ${func}(JSContext *ctx, JSValueConst new_target, int argc, JSValu
 			}
 		} else {
 #ifdef DEBUG_METHODS_ENABLED
-			ERR_FAIL_COND_V(false, (JS_ThrowTypeError(ctx, "Array or ArrayBuffer expected for argument #0 of ${class}(from)")));
+			ERR_FAIL_COND_V(false, (JS_ThrowTypeError(ctx, "Array, TypedArray or ArrayBuffer expected for argument #0 of ${class}(from)")));
 #endif
 		}
 	}
@@ -711,5 +722,42 @@ ${definitions}
 	file = open(OUTPUT_FILE, 'w')
 	file.write(output)
 
+def generate_method_signatures():
+	Template = '''\
+/* THIS FILE IS GENERATED DO NOT EDIT */
+#include "quickjs_class_table.h"
+
+const Variant::Type QuickJSClassTable::SIGNATURE_ARGUMENT_TYPES[] = {
+${arguments}
+};
+
+const QuickJSClassTable::MethodSignature QuickJSClassTable::METHOD_SIGNATURES[] = {
+${signatures}
+};
+
+const int QuickJSClassTable::METHOD_SIGNATURE_COUNT = ${count};
+'''
+	signatures = json.load(open(os.path.join(DIR, '..', 'method_signatures.gen.json'), 'r'))
+	arguments = ''
+	entries = ''
+	argument_count = 0
+	for sig in signatures:
+		entries += '\t{ "%s", "%s", Variant::%s, %d, %d },\n' % (sig['class'], sig['name'], sig['return'], len(sig['arguments']), argument_count)
+		for arg in sig['arguments']:
+			arguments += '\tVariant::%s,\n' % arg
+		argument_count += len(sig['arguments'])
+	# Keeps the arrays non empty
+	arguments += '\tVariant::NIL,\n'
+	entries += '\t{ NULL, NULL, Variant::NIL, 0, 0 },\n'
+
+	output = apply_parttern(Template, {
+		'arguments': arguments.rstrip('\n'),
+		'signatures': entries.rstrip('\n'),
+		'count': str(len(signatures)),
+	})
+	file = open(os.path.join(DIR, "quickjs_method_signatures.gen.cpp"), 'w')
+	file.write(output)
+
 if __name__ == "__main__":
 	generate_builtin_bindings()
+	generate_method_signatures()
@@ -1818,6 +1818,16 @@ BOOL JS_IsJobPending(JSRuntime *rt)
     return !list_empty(&rt->job_list);
 }
 
+int JS_GetPendingJobCount(JSRuntime *rt)
+{
+    struct list_head *el;
+    int count = 0;
+    list_for_each(el, &rt->job_list) {
+        count++;
+    }
+    return count;
+}
+
 /* return < 0 if exception, 0 if no job pending, 1 if a job was
    executed successfully. the context of the job is stored in '*pctx' */
 int JS_ExecutePendingJob(JSRuntime *rt, JSContext **pctx)
@@ -2351,6 +2361,12 @@ void JS_SetMaxStackSize(JSRuntime *rt, size_t stack_size)
     rt->stack_size = stack_size;
 }
 
+/* Must be called before using the runtime from a different thread */
+void JS_UpdateStackTop(JSRuntime *rt)
+{
+    rt->stack_top = js_get_stack_pointer();
+}
+
 static inline BOOL is_strict_mode(JSContext *ctx)
 {
     JSStackFrame *sf = ctx->rt->current_stack_frame;
@@ -4706,12 +4722,13 @@ static __maybe_unused void JS_DumpShapes(JSRuntime *rt)
     printf("}\n");
 }
 
-static JSValue JS_NewObjectFromShape(JSContext *ctx, JSShape *sh, JSClassID class_id)
+/* 'inline_size' bytes are allocated after the object and used as its opaque data */
+static JSValue JS_NewObjectFromShapeInline(JSContext *ctx, JSShape *sh, JSClassID class_id, size_t inline_size)
 {
     JSObject *p;
 
-    js_trigger_gc(ctx->rt, sizeof(JSObject));
-    p = js_malloc(ctx, sizeof(JSObject));
+    js_trigger_gc(ctx->rt, sizeof(JSObject) + inline_size);
+    p = js_malloc(ctx, sizeof(JSObject) + inline_size);
     if (unlikely(!p))
         goto fail;
     p->class_id = class_id;
@@ -4724,7 +4741,7 @@ static JSValue JS_NewObjectFromShape(JSContext *ctx, JSShape *sh, JSClassID clas
     p->tmp_mark = 0;
     p->is_HTMLDDA = 0;
     p->first_weak_ref = NULL;
-    p->u.opaque = NULL;
+    p->u.opaque = inline_size ? (void *)(p + 1) : NULL;
     p->shape = sh;
     p->prop = js_malloc(ctx, sizeof(JSProperty) * sh->prop_size);
     if (unlikely(!p->prop)) {
@@ -4811,6 +4828,11 @@ static JSValue JS_NewObjectFromShape(JSContext *ctx, JSShape *sh, JSClassID clas
     return JS_MKPTR(JS_TAG_OBJECT, p);
 }
 
+static JSValue JS_NewObjectFromShape(JSContext *ctx, JSShape *sh, JSClassID class_id)
+{
+    return JS_NewObjectFromShapeInline(ctx, sh, class_id, 0);
+}
+
 static JSObject *get_proto_obj(JSValueConst proto_val)
 {
     if (JS_VALUE_GET_TAG(proto_val) != JS_TAG_OBJECT)
@@ -33379,7 +33401,9 @@ static JSValue __JS_EvalInternal(JSContext *ctx, JSValueConst this_obj,
     /* Could add a flag to avoid resolution if necessary */
     if (m) {
         m->func_obj = fun_obj;
-        if (js_resolve_module(ctx, m) < 0)
+        if ((flags & (JS_EVAL_FLAG_COMPILE_ONLY | JS_EVAL_FLAG_NO_RESOLVE)) !=
+            (JS_EVAL_FLAG_COMPILE_ONLY | JS_EVAL_FLAG_NO_RESOLVE) &&
+            js_resolve_module(ctx, m) < 0)
             goto fail1;
         fun_obj = JS_DupValue(ctx, JS_MKPTR(JS_TAG_MODULE, m));
     }
@@ -53646,6 +53670,17 @@ JSAtom JS_GetModuleExportEntryName(JSContext *ctx, JSModuleDef *m, int idx) {
     return JS_DupAtom(ctx, m->export_entries[idx].export_name);
 }
 
+int JS_GetModuleRequestCount(JSModuleDef *m) {
+    return m->req_module_entries_count;
+}
+
+/* Module specifier as written in the import statement, not normalized */
+JSAtom JS_GetModuleRequestName(JSContext *ctx, JSModuleDef *m, int idx) {
+    if (idx >= m->req_module_entries_count || idx < 0)
+        return JS_ATOM_NULL;
+    return JS_DupAtom(ctx, m->req_module_entries[idx].module_name);
+}
+
 JS_BOOL JS_IsPureCFunction(JSContext *ctx, JSValue val) {
     JSObject *p;
     if (JS_VALUE_GET_TAG(val) != JS_TAG_OBJECT)
@@ -53694,6 +53729,132 @@ JS_BOOL JS_IsArrayBuffer(JSValueConst val) {
     }
 }
 
+JS_BOOL JS_IsSharedArrayBuffer(JSValueConst val) {
+    JSObject *p;
+    if (JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT) {
+        p = JS_VALUE_GET_OBJ(val);
+        return p->class_id == JS_CLASS_SHARED_ARRAY_BUFFER;
+    } else {
+        return FALSE;
+    }
+}
+
+JS_BOOL JS_IsTypedArray(JSValueConst val) {
+    JSObject *p;
+    if (JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT) {
+        p = JS_VALUE_GET_OBJ(val);
+        return p->class_id >= JS_CLASS_UINT8C_ARRAY && p->class_id <= JS_CLASS_FLOAT64_ARRAY;
+    } else {
+        return FALSE;
+    }
+}
+
+/* Return the class name of a typed array or JS_ATOM_NULL */
+JSAtom JS_GetTypedArrayClassName(JSContext *ctx, JSValueConst val)
+{
+    if (!JS_IsTypedArray(val))
+        return JS_ATOM_NULL;
+    return JS_DupAtom(ctx, ctx->rt->class_array[JS_VALUE_GET_OBJ(val)->class_id].class_name);
+}
+
+/* Return the opaque of an ArrayBuffer created by JS_NewArrayBuffer() with
+   'free_func', NULL for any other buffer */
+void *JS_GetArrayBufferOpaque(JSValueConst obj, JSFreeArrayBufferDataFunc *free_func)
+{
+    JSArrayBuffer *abuf;
+    if (!JS_IsArrayBuffer(obj))
+        return NULL;
+    abuf = JS_VALUE_GET_OBJ(obj)->u.array_buffer;
+    if (abuf->detached || abuf->free_func != free_func)
+        return NULL;
+    return abuf->opaque;
+}
+
+/* Detach an ArrayBuffer and return its data without freeing it. Only
+   buffers allocated by the runtime allocator or created with 'free_func'
+   are accepted, the caller frees the data. Return NULL otherwise. */
+uint8_t *JS_StealArrayBuffer(JSContext *ctx, size_t *psize, JSValueConst obj,
+                             JSFreeArrayBufferDataFunc *free_func)
+{
+    JSArrayBuffer *abuf;
+    uint8_t *data;
+    if (!JS_IsArrayBuffer(obj))
+        return NULL;
+    abuf = JS_VALUE_GET_OBJ(obj)->u.array_buffer;
+    if (abuf->detached || (abuf->free_func != js_array_buffer_free &&
+                           abuf->free_func != free_func))
+        return NULL;
+    data = abuf->data;
+    *psize = abuf->byte_length;
+    abuf->free_func = NULL;
+    JS_DetachArrayBuffer(ctx, obj);
+    return data;
+}
+
+/* Create a fast array of 'len' undefined elements. The elements can be
+   filled in place through JS_GetFastArray() before the array is exposed. */
+JSValue JS_NewArrayWithLength(JSContext *ctx, uint32_t len)
+{
+    JSValue obj;
+    JSObject *p;
+    JSValue *values;
+    uint32_t i;
+
+    obj = JS_NewArray(ctx);
+    if (JS_IsException(obj) || len == 0)
+        return obj;
+    if (len > INT32_MAX / sizeof(JSValue)) {
+        JS_FreeValue(ctx, obj);
+        return JS_ThrowRangeError(ctx, "invalid array length");
+    }
+    values = js_malloc(ctx, sizeof(JSValue) * len);
+    if (!values) {
+        JS_FreeValue(ctx, obj);
+        return JS_EXCEPTION;
+    }
+    for(i = 0; i < len; i++)
+        values[i] = JS_UNDEFINED;
+    p = JS_VALUE_GET_OBJ(obj);
+    p->u.array.u.values = values;
+    p->u.array.u1.size = len;
+    p->u.array.count = len;
+    p->prop[0].u.value = JS_NewUint32(ctx, len);
+    return obj;
+}
+
+JS_BOOL JS_GetFastArray(JSValueConst obj, JSValue **arrpp, uint32_t *countp)
+{
+    if (JS_VALUE_GET_TAG(obj) == JS_TAG_OBJECT) {
+        JSObject *p = JS_VALUE_GET_OBJ(obj);
+        if (p->class_id == JS_CLASS_ARRAY && p->fast_array) {
+            *countp = p->u.array.count;
+            *arrpp = p->u.array.u.values;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* Create an object of a C class whose opaque data is stored in the
+   same allocation as the object. The storage is released with the object. */
+JSValue JS_NewObjectProtoClassInline(JSContext *ctx, JSValueConst proto_val,
+                                     JSClassID class_id, size_t inline_size)
+{
+    JSShape *sh;
+    JSObject *proto;
+
+    proto = get_proto_obj(proto_val);
+    sh = find_hashed_shape_proto(ctx->rt, proto);
+    if (likely(sh)) {
+        sh = js_dup_shape(sh);
+    } else {
+        sh = js_new_shape(ctx, proto);
+        if (!sh)
+            return JS_EXCEPTION;
+    }
+    return JS_NewObjectFromShapeInline(ctx, sh, class_id, inline_size);
+}
+
 JS_BOOL JS_IsDataView(JSValueConst val) {
     JSObject *p;
     if (JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT) {
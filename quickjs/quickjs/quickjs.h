@@ -307,6 +307,9 @@ static inline JS_BOOL JS_VALUE_IS_NAN(JSValue v)
 #define JS_EVAL_FLAG_COMPILE_ONLY (1 << 5)
 /* don't include the stack frames before this eval in the Error() backtraces */
 #define JS_EVAL_FLAG_BACKTRACE_BARRIER (1 << 6)
+/* with JS_EVAL_FLAG_COMPILE_ONLY, leave the imports of a module
+   unloaded. Link it with JS_ResolveModule() before evaluating it. */
+#define JS_EVAL_FLAG_NO_RESOLVE (1 << 7)
 
 typedef JSValue JSCFunction(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 typedef JSValue JSCFunctionMagic(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv, int magic);
@@ -334,6 +337,7 @@ void JS_SetRuntimeInfo(JSRuntime *rt, const char *info);
 void JS_SetMemoryLimit(JSRuntime *rt, size_t limit);
 void JS_SetGCThreshold(JSRuntime *rt, size_t gc_threshold);
 void JS_SetMaxStackSize(JSRuntime *rt, size_t stack_size);
+void JS_UpdateStackTop(JSRuntime *rt);
 JSRuntime *JS_NewRuntime2(const JSMallocFunctions *mf, void *opaque);
 void JS_FreeRuntime(JSRuntime *rt);
 void *JS_GetRuntimeOpaque(JSRuntime *rt);
@@ -865,6 +869,7 @@ typedef JSValue JSJobFunc(JSContext *ctx, int argc, JSValueConst *argv);
 int JS_EnqueueJob(JSContext *ctx, JSJobFunc *job_func, int argc, JSValueConst *argv);
 
 JS_BOOL JS_IsJobPending(JSRuntime *rt);
+int JS_GetPendingJobCount(JSRuntime *rt);
 int JS_ExecutePendingJob(JSRuntime *rt, JSContext **pctx);
 
 /* Object Writer/Reader (currently only used to handle precompiled code) */
@@ -1033,12 +1038,22 @@ int JS_SetModuleExportList(JSContext *ctx, JSModuleDef *m,
 int JS_GetModuleExportEntriesCount(JSModuleDef *m);
 JSValue JS_GetModuleExportEntry(JSContext *ctx, JSModuleDef *m, int idx);
 JSAtom JS_GetModuleExportEntryName(JSContext *ctx, JSModuleDef *m, int idx);
+int JS_GetModuleRequestCount(JSModuleDef *m);
+JSAtom JS_GetModuleRequestName(JSContext *ctx, JSModuleDef *m, int idx);
 JSValue JS_GetStackFunction(JSContext *ctx, int back_level);
 JS_BOOL JS_IsPureCFunction(JSContext *ctx, JSValue val);
 const JSMallocState *JS_GetMollocState(JSRuntime *rt);
 int JS_GetRefCount(JSValue val);
 JS_BOOL JS_IsArrayBuffer(JSValueConst val);
+JS_BOOL JS_IsSharedArrayBuffer(JSValueConst val);
 JS_BOOL JS_IsDataView(JSValueConst val);
+JS_BOOL JS_IsTypedArray(JSValueConst val);
+JSAtom JS_GetTypedArrayClassName(JSContext *ctx, JSValueConst val);
+void *JS_GetArrayBufferOpaque(JSValueConst obj, JSFreeArrayBufferDataFunc *free_func);
+uint8_t *JS_StealArrayBuffer(JSContext *ctx, size_t *psize, JSValueConst obj, JSFreeArrayBufferDataFunc *free_func);
+JSValue JS_NewObjectProtoClassInline(JSContext *ctx, JSValueConst proto, JSClassID class_id, size_t inline_size);
+JSValue JS_NewArrayWithLength(JSContext *ctx, uint32_t len);
+JS_BOOL JS_GetFastArray(JSValueConst obj, JSValue **arrpp, uint32_t *countp);
 
 #undef js_unlikely
 #undef js_force_inline
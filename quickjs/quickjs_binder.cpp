@@ -6,12 +6,18 @@
 #include "core/engine.h"
 #include "core/global_constants.h"
 #include "core/io/json.h"
+#include "core/io/marshalls.h"
 #include "core/math/expression.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "quickjs_binder.h"
+#include "quickjs_bytecode_cache.h"
+#include "quickjs_class_table.h"
+#include "quickjs_module_prefetcher.h"
+#include "quickjs_module_resolver.h"
 #include "quickjs_worker.h"
+#include "quickjs_worker_pool.h"
 #ifdef TOOLS_ENABLED
 #include "editor/editor_settings.h"
 #endif
@@ -20,26 +26,64 @@ uint32_t QuickJSBinder::global_context_id = 0;
 uint64_t QuickJSBinder::global_transfer_id = 0;
 HashMap<uint64_t, Variant> QuickJSBinder::transfer_deopot;
 Map<String, const char *> QuickJSBinder::class_remap;
-List<String> compiling_modules;
+Mutex *QuickJSBinder::binding_script_mutex = NULL;
+Vector<uint8_t> QuickJSBinder::binding_script_bytecode;
 
+// Argument frames keep common arities on the stack and only use the heap past STACK_ARGUMENT_COUNT
 struct GodotMethodArguments {
 	Variant *arguments;
 	const Variant **ptr;
-	GodotMethodArguments(int argc) {
-		if (argc) {
+	int argc;
+	alignas(Variant) uint8_t stack_arguments[sizeof(Variant) * STACK_ARGUMENT_COUNT];
+	const Variant *stack_ptr[STACK_ARGUMENT_COUNT];
+
+	GodotMethodArguments(int p_argc) {
+		argc = p_argc;
+		if (argc <= 0) {
+			arguments = NULL;
+			ptr = NULL;
+			return;
+		}
+		if (argc <= STACK_ARGUMENT_COUNT) {
+			arguments = reinterpret_cast<Variant *>(stack_arguments);
+			ptr = stack_ptr;
+			for (int i = 0; i < argc; i++) {
+				memnew_placement(&arguments[i], Variant);
+			}
+		} else {
 			arguments = memnew_arr(Variant, argc);
 			ptr = memnew_arr(const Variant *, argc);
+		}
+		for (int i = 0; i < argc; i++) {
+			ptr[i] = &arguments[i];
+		}
+	}
+	~GodotMethodArguments() {
+		if (argc <= 0) return;
+		if (argc <= STACK_ARGUMENT_COUNT) {
 			for (int i = 0; i < argc; i++) {
-				ptr[i] = &arguments[i];
+				arguments[i].~Variant();
 			}
 		} else {
-			arguments = NULL;
-			ptr = NULL;
+			memdelete_arr(ptr);
+			memdelete_arr(arguments);
 		}
 	}
-	~GodotMethodArguments() {
-		if (ptr) memdelete_arr(ptr);
-		if (arguments) memdelete_arr(arguments);
+};
+
+struct JSMethodArguments {
+	JSValue *argv;
+	int argc;
+	JSValue stack_argv[STACK_ARGUMENT_COUNT];
+
+	JSMethodArguments(int p_argc) {
+		argc = p_argc;
+		argv = argc > STACK_ARGUMENT_COUNT ? memnew_arr(JSValue, argc) : stack_argv;
+	}
+	~JSMethodArguments() {
+		if (argv != stack_argv) {
+			memdelete_arr(argv);
+		}
 	}
 };
 
@@ -134,7 +178,136 @@ void QuickJSBinder::add_global_properties() {
 	// globalThis.cancelAnimationFrame
 	JSValue js_func_cancelAnimationFrame = JS_NewCFunction(ctx, global_cancel_animation_frame, "cancelAnimationFrame", 1);
 	JS_DefinePropertyValueStr(ctx, global_object, "cancelAnimationFrame", js_func_cancelAnimationFrame, PROP_DEF_DEFAULT);
+	// globalThis.setTimeout globalThis.setInterval
+	JSValue js_func_setTimeout = JS_NewCFunctionMagic(ctx, global_set_timer, "setTimeout", 2, JS_CFUNC_generic_magic, 0);
+	JS_DefinePropertyValueStr(ctx, global_object, "setTimeout", js_func_setTimeout, PROP_DEF_DEFAULT);
+	JSValue js_func_setInterval = JS_NewCFunctionMagic(ctx, global_set_timer, "setInterval", 2, JS_CFUNC_generic_magic, 1);
+	JS_DefinePropertyValueStr(ctx, global_object, "setInterval", js_func_setInterval, PROP_DEF_DEFAULT);
+	// globalThis.clearTimeout globalThis.clearInterval
+	JSValue js_func_clearTimeout = JS_NewCFunction(ctx, global_clear_timer, "clearTimeout", 1);
+	JS_DefinePropertyValueStr(ctx, global_object, "clearTimeout", js_func_clearTimeout, PROP_DEF_DEFAULT);
+	JSValue js_func_clearInterval = JS_NewCFunction(ctx, global_clear_timer, "clearInterval", 1);
+	JS_DefinePropertyValueStr(ctx, global_object, "clearInterval", js_func_clearInterval, PROP_DEF_DEFAULT);
+	// globalThis.queueMicrotask
+	JSValue js_func_queueMicrotask = JS_NewCFunction(ctx, global_queue_microtask, "queueMicrotask", 1);
+	JS_DefinePropertyValueStr(ctx, global_object, "queueMicrotask", js_func_queueMicrotask, PROP_DEF_DEFAULT);
+}
+
+#ifdef PTRCALL_ENABLED
+// Call the method with native arguments through MethodBind::ptrcall without boxing them into Variants.
+// The types come from the generated signature table, returns false if the call is not supported
+// by the fast path so it can be done with MethodBind::call
+static bool object_method_ptrcall(JSContext *ctx, const QuickJSClassTable::Method &p_method, Object *p_object, int argc, JSValueConst *argv, JSValue &r_ret) {
+
+	const QuickJSClassTable::MethodSignature *signature = p_method.signature;
+	if (!signature || argc != signature->argument_count || argc > STACK_ARGUMENT_COUNT) {
+		return false;
+	}
+	MethodBind *mb = p_method.bind;
+	const Variant::Type return_type = signature->return_type;
+	const Variant::Type *argument_types = QuickJSClassTable::SIGNATURE_ARGUMENT_TYPES + signature->argument_begin;
+
+	union {
+		bool _bool;
+		int64_t _int;
+		double _real;
+	} values[STACK_ARGUMENT_COUNT];
+	String strings[STACK_ARGUMENT_COUNT];
+	const void *ptr_args[STACK_ARGUMENT_COUNT];
+
+	for (int i = 0; i < argc; i++) {
+		JSValueConst value = argv[i];
+		Variant::Type type = argument_types[i];
+		switch (type) {
+			case Variant::BOOL:
+				if (!JS_IsBool(value)) return false;
+				values[i]._bool = JS_VALUE_GET_BOOL(value);
+				ptr_args[i] = &values[i]._bool;
+				break;
+			case Variant::INT:
+				if (!JS_IsNumber(value)) return false;
+				values[i]._int = QuickJSBinder::js_to_int64(ctx, value);
+				ptr_args[i] = &values[i]._int;
+				break;
+			case Variant::REAL:
+				if (!JS_IsNumber(value)) return false;
+				JS_ToFloat64(ctx, &values[i]._real, value);
+				ptr_args[i] = &values[i]._real;
+				break;
+			case Variant::STRING:
+				if (!JS_IsString(value)) return false;
+				strings[i] = QuickJSBinder::js_to_string(ctx, value);
+				ptr_args[i] = &strings[i];
+				break;
+			case Variant::VECTOR2:
+			case Variant::RECT2:
+			case Variant::VECTOR3:
+			case Variant::TRANSFORM2D:
+			case Variant::PLANE:
+			case Variant::QUAT:
+			case Variant::AABB:
+			case Variant::BASIS:
+			case Variant::TRANSFORM:
+			case Variant::COLOR: {
+				// Pass the value stored in the binding directly
+				ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, value);
+				if (!bind || bind->type != type) return false;
+				ptr_args[i] = bind->godot_builtin_object_ptr;
+			} break;
+			default:
+				return false;
+		}
+	}
+
+#define PTRCALL_RETURN_BUILTIN(m_type, m_class)                                                \
+	case Variant::m_type: {                                                                    \
+		m_class ret;                                                                           \
+		mb->ptrcall(p_object, ptr_args, &ret);                                                 \
+		r_ret = QuickJSBuiltinBinder::create_builtin_value(ctx, Variant::m_type, &ret);        \
+	} break;
+
+	switch (return_type) {
+		case Variant::NIL:
+			mb->ptrcall(p_object, ptr_args, NULL);
+			r_ret = JS_UNDEFINED;
+			break;
+		case Variant::BOOL: {
+			bool ret = false;
+			mb->ptrcall(p_object, ptr_args, &ret);
+			r_ret = JS_NewBool(ctx, ret);
+		} break;
+		case Variant::INT: {
+			int64_t ret = 0;
+			mb->ptrcall(p_object, ptr_args, &ret);
+			r_ret = JS_NewInt64(ctx, ret);
+		} break;
+		case Variant::REAL: {
+			double ret = 0;
+			mb->ptrcall(p_object, ptr_args, &ret);
+			r_ret = JS_NewFloat64(ctx, ret);
+		} break;
+		case Variant::STRING: {
+			String ret;
+			mb->ptrcall(p_object, ptr_args, &ret);
+			r_ret = QuickJSBinder::to_js_string(ctx, ret);
+		} break;
+			PTRCALL_RETURN_BUILTIN(VECTOR2, Vector2)
+			PTRCALL_RETURN_BUILTIN(RECT2, Rect2)
+			PTRCALL_RETURN_BUILTIN(VECTOR3, Vector3)
+			PTRCALL_RETURN_BUILTIN(TRANSFORM2D, Transform2D)
+			PTRCALL_RETURN_BUILTIN(PLANE, Plane)
+			PTRCALL_RETURN_BUILTIN(QUAT, Quat)
+			PTRCALL_RETURN_BUILTIN(AABB, AABB)
+			PTRCALL_RETURN_BUILTIN(BASIS, Basis)
+			PTRCALL_RETURN_BUILTIN(TRANSFORM, Transform)
+			PTRCALL_RETURN_BUILTIN(COLOR, Color)
+		default:
+			return false;
+	}
+#undef PTRCALL_RETURN_BUILTIN
+	return true;
 }
+#endif
 
 JSValue QuickJSBinder::object_method(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv, int method_id) {
 
@@ -144,14 +317,27 @@ JSValue QuickJSBinder::object_method(JSContext *ctx, JSValueConst this_val, int
 
 	QuickJSBinder *binder = QuickJSBinder::get_context_binder(ctx);
 	Object *obj = bind->get_godot_object();
-	MethodBind *mb = binder->godot_methods[method_id];
+	const QuickJSClassTable::Method &method = binder->class_table->methods[method_id];
+	MethodBind *mb = method.bind;
 
 	if (!mb->is_vararg()) {
 		argc = MIN(argc, mb->get_argument_count());
 	}
 
+#ifdef PTRCALL_ENABLED
+	JSValue ptrcall_ret;
+	if (object_method_ptrcall(ctx, method, obj, argc, argv, ptrcall_ret)) {
+		return ptrcall_ret;
+	}
+#endif
+
 	GodotMethodArguments args(argc);
 	for (int i = 0; i < argc; ++i) {
+#ifdef DEBUG_METHODS_ENABLED
+		if (i < mb->get_argument_count() && js_array_to_pool_variant(ctx, argv[i], mb->get_argument_type(i), args.arguments[i])) {
+			continue;
+		}
+#endif
 		args.arguments[i] = var_to_variant(ctx, argv[i]);
 	}
 
@@ -203,7 +389,7 @@ JSValue QuickJSBinder::object_indexed_property(JSContext *ctx, JSValue this_val,
 	bool is_setter = argc > 0;
 
 	Object *obj = bind->get_godot_object();
-	const ClassDB::PropertySetGet *prop = binder->godot_object_indexed_properties[property_id];
+	const ClassDB::PropertySetGet *prop = binder->class_table->indexed_properties[property_id];
 	MethodBind *mb = is_setter ? prop->_setptr : prop->_getptr;
 
 	GodotMethodArguments args(2);
@@ -231,6 +417,12 @@ JSValue QuickJSBinder::variant_to_var(JSContext *ctx, const Variant p_var) {
 		case Variant::OBJECT: {
 			Object *obj = p_var;
 			if (obj == NULL) return JS_NULL;
+			if (is_transferred_buffer(obj)) {
+				ContainerConversionState state;
+				JSValue ret = transferred_to_var(ctx, obj, state);
+				free_conversion_state(ctx, state);
+				return ret;
+			}
 			ECMAScriptGCHandler *data = BINDING_DATA_FROM_GD(ctx, obj);
 			ERR_FAIL_NULL_V(data, JS_UNDEFINED);
 			ERR_FAIL_NULL_V(data->ecma_object, JS_UNDEFINED);
@@ -244,25 +436,12 @@ JSValue QuickJSBinder::variant_to_var(JSContext *ctx, const Variant p_var) {
 
 			return js_obj;
 		}
-		case Variant::ARRAY: {
-			Array arr = p_var;
-			JSValue js_arr = JS_NewArray(ctx);
-			for (uint32_t i = 0; i < arr.size(); i++) {
-				JS_SetPropertyUint32(ctx, js_arr, i, variant_to_var(ctx, arr[int(i)]));
-			}
-			return js_arr;
-		}
+		case Variant::ARRAY:
 		case Variant::DICTIONARY: {
-			Dictionary dict = p_var;
-			JSValue obj = JS_NewObject(ctx);
-			Array keys = dict.keys();
-			for (int i = 0; i < keys.size(); i++) {
-				const Variant &key = keys[i];
-				const Variant &value = dict[key];
-				String key_str = keys[i];
-				JS_SetPropertyStr(ctx, obj, key_str.utf8().get_data(), variant_to_var(ctx, value));
-			}
-			return obj;
+			ContainerConversionState state;
+			JSValue ret = container_to_var(ctx, p_var, state);
+			free_conversion_state(ctx, state);
+			return ret;
 		}
 		case Variant::NIL:
 			return JS_NULL;
@@ -272,6 +451,21 @@ JSValue QuickJSBinder::variant_to_var(JSContext *ctx, const Variant p_var) {
 }
 
 Variant QuickJSBinder::var_to_variant(JSContext *ctx, JSValue p_val) {
+	VariantConversionState state;
+	state.share_references = get_context_binder(ctx)->share_converted_references;
+	Variant ret = var_to_variant(ctx, p_val, state);
+	free_conversion_state(ctx, state);
+	return ret;
+}
+
+void QuickJSBinder::free_conversion_state(JSContext *ctx, VariantConversionState &r_state) {
+	for (int i = 0; i < r_state.retained.size(); i++) {
+		JS_FreeValue(ctx, r_state.retained[i]);
+	}
+	r_state.retained.clear();
+}
+
+Variant QuickJSBinder::var_to_variant(JSContext *ctx, JSValue p_val, VariantConversionState &r_state) {
 	int64_t tag = JS_VALUE_GET_TAG(p_val);
 	switch (tag) {
 		case JS_TAG_INT:
@@ -286,16 +480,12 @@ Variant QuickJSBinder::var_to_variant(JSContext *ctx, JSValue p_val) {
 			if (JS_VALUE_GET_PTR(p_val) == NULL) {
 				return Variant();
 			}
+			if (r_state.clone_buffers && (JS_IsArrayBuffer(p_val) || JS_IsSharedArrayBuffer(p_val) || JS_IsTypedArray(p_val))) {
+				return js_to_transferred_buffer(ctx, p_val, r_state);
+			}
 			int length = get_js_array_length(ctx, p_val);
 			if (length != -1) { // Array
-				Array arr;
-				arr.resize(length);
-				for (uint32_t i = 0; i < length; i++) {
-					JSValue val = JS_GetPropertyUint32(ctx, p_val, i);
-					arr[int(i)] = var_to_variant(ctx, val);
-					JS_FreeValue(ctx, val);
-				}
-				return arr;
+				return js_to_array(ctx, p_val, length, r_state);
 			} else if (ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, p_val)) { // Binding object
 				ERR_FAIL_NULL_V(bind, Variant());
 				ERR_FAIL_NULL_V(bind->godot_object, Variant());
@@ -306,8 +496,7 @@ Variant QuickJSBinder::var_to_variant(JSContext *ctx, JSValue p_val) {
 				JS_FreeValue(ctx, name);
 				return ret;
 			} else { // Plain Object as Dictionary
-				List<void *> stack;
-				return js_to_dictionary(ctx, p_val, stack);
+				return js_to_dictionary(ctx, p_val, r_state);
 			}
 		} break;
 		case JS_TAG_NULL:
@@ -324,6 +513,334 @@ Variant QuickJSBinder::var_to_variant(JSContext *ctx, JSValue p_val) {
 	}
 }
 
+// Transferred buffers backed by a pool array are moved without copying, any other buffer is copied once
+// SharedArrayBuffers keep sharing their memory with the sender
+Variant QuickJSBinder::js_to_transferred_buffer(JSContext *ctx, JSValueConst p_val, VariantConversionState &r_state) {
+	size_t byte_offset = 0;
+	size_t byte_length = 0;
+	size_t bytes_per_element = 1;
+	JSValue array_buffer;
+	if (JS_IsTypedArray(p_val)) {
+		array_buffer = JS_GetTypedArrayBuffer(ctx, p_val, &byte_offset, &byte_length, &bytes_per_element);
+		if (JS_IsException(array_buffer)) {
+			JS_FreeValue(ctx, JS_GetException(ctx));
+			ERR_FAIL_V_MSG(Variant(), "Cannot send a TypedArray whose buffer is detached");
+		}
+	} else {
+		array_buffer = JS_DupValue(ctx, p_val);
+	}
+
+	const void *key = JS_VALUE_GET_PTR(array_buffer);
+	size_t size = 0;
+	Ref<QuickJSTransferredBuffer> buffer;
+	if (const Ref<QuickJSTransferredBuffer> *converted = r_state.buffers.getptr(key)) {
+		buffer = *converted;
+	} else {
+		buffer.instance();
+		if (JS_IsSharedArrayBuffer(array_buffer)) {
+			buffer->shared_data = JS_GetArrayBuffer(ctx, &size, array_buffer);
+			buffer->shared_size = size;
+			QuickJSSharedMemory::dup(NULL, buffer->shared_data);
+		} else if (r_state.transfer.has(key) && QuickJSBuiltinBinder::get_array_buffer_pool(array_buffer, buffer->storage)) {
+			// The pool array is moved with its buffer
+		} else if (r_state.transfer.has(key) && (buffer->owned_data = JS_StealArrayBuffer(ctx, &size, array_buffer, QuickJSTransferredBuffer::free_owned_data))) {
+			// Runtimes share the allocator so the memory is handed over, the sender's buffer is detached
+			buffer->owned_size = size;
+		} else {
+			uint8_t *data = JS_GetArrayBuffer(ctx, &size, array_buffer);
+			PoolByteArray bytes;
+			if (data == NULL) { // Detached buffers are sent empty
+				JS_FreeValue(ctx, JS_GetException(ctx));
+			} else if (size) {
+				bytes.resize(size);
+				copymem(bytes.write().ptr(), data, size);
+			}
+			buffer->storage = bytes;
+		}
+		r_state.buffers.set(key, buffer);
+		// The key must not be reused by another buffer before the message is converted
+		r_state.retained.push_back(JS_DupValue(ctx, array_buffer));
+	}
+
+	Variant ret = buffer;
+	if (JS_IsTypedArray(p_val)) {
+		Ref<QuickJSTransferredView> view;
+		view.instance();
+		view->buffer = buffer;
+		JSAtom class_name = JS_GetTypedArrayClassName(ctx, p_val);
+		const char *name = JS_AtomToCString(ctx, class_name);
+		view->class_name = name;
+		JS_FreeCString(ctx, name);
+		JS_FreeAtom(ctx, class_name);
+		view->byte_offset = byte_offset;
+		view->length = byte_length / bytes_per_element;
+		ret = view;
+	}
+	JS_FreeValue(ctx, array_buffer);
+	return ret;
+}
+
+bool QuickJSBinder::js_to_message(JSContext *ctx, JSValueConst p_message, JSValueConst p_transfer, Variant &r_message) {
+	VariantConversionState state;
+	state.share_references = get_context_binder(ctx)->share_converted_references;
+	state.clone_buffers = true;
+
+	Vector<JSValue> transfer;
+	if (!JS_IsUndefined(p_transfer) && !JS_IsNull(p_transfer)) {
+		int length = get_js_array_length(ctx, p_transfer);
+		if (length == -1) {
+			JS_ThrowTypeError(ctx, "Array expected for the transfer list");
+			return false;
+		}
+		for (int i = 0; i < length; i++) {
+			JSValue item = JS_GetPropertyUint32(ctx, p_transfer, i);
+			bool valid = false;
+			if (JS_IsArrayBuffer(item)) {
+				size_t size = 0;
+				if (JS_GetArrayBuffer(ctx, &size, item) == NULL) {
+					// Detached buffers throw, empty pool arrays have no data
+					JSValue e = JS_GetException(ctx);
+					valid = JS_IsNull(e);
+					JS_FreeValue(ctx, e);
+				} else {
+					valid = true;
+				}
+			} else if (ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, item)) {
+				valid = bind->type >= Variant::POOL_BYTE_ARRAY && bind->type <= Variant::POOL_COLOR_ARRAY;
+			}
+			if (!valid || state.transfer.has(JS_VALUE_GET_PTR(item))) {
+				JS_FreeValue(ctx, item);
+				for (int j = 0; j < transfer.size(); j++) {
+					JS_FreeValue(ctx, transfer[j]);
+				}
+				JS_ThrowTypeError(ctx, "The transfer list must hold distinct ArrayBuffers and pool arrays");
+				return false;
+			}
+			state.transfer.set(JS_VALUE_GET_PTR(item), true);
+			transfer.push_back(item);
+		}
+	}
+
+	r_message = var_to_variant(ctx, p_message, state);
+	free_conversion_state(ctx, state);
+
+	// The receiver owns the transferred memory from now on
+	for (int i = 0; i < transfer.size(); i++) {
+		JSValue item = transfer[i];
+		if (JS_IsArrayBuffer(item)) {
+			JS_DetachArrayBuffer(ctx, item);
+		} else {
+			ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, item);
+			switch (bind->type) {
+				case Variant::POOL_BYTE_ARRAY:
+					*bind->getPoolByteArray() = PoolByteArray();
+					break;
+				case Variant::POOL_INT_ARRAY:
+					*bind->getPoolIntArray() = PoolIntArray();
+					break;
+				case Variant::POOL_REAL_ARRAY:
+					*bind->getPoolRealArray() = PoolRealArray();
+					break;
+				case Variant::POOL_STRING_ARRAY:
+					*bind->getPoolStringArray() = PoolStringArray();
+					break;
+				case Variant::POOL_VECTOR2_ARRAY:
+					*bind->getPoolVector2Array() = PoolVector2Array();
+					break;
+				case Variant::POOL_VECTOR3_ARRAY:
+					*bind->getPoolVector3Array() = PoolVector3Array();
+					break;
+				case Variant::POOL_COLOR_ARRAY:
+					*bind->getPoolColorArray() = PoolColorArray();
+					break;
+				default:
+					break;
+			}
+		}
+		JS_FreeValue(ctx, item);
+	}
+	return true;
+}
+
+// Dictionary keys are converted to atoms once per conversion so arrays of similar dictionaries share them
+JSValue QuickJSBinder::container_to_var(JSContext *ctx, const Variant &p_var, ContainerConversionState &r_state) {
+	if (p_var.get_type() == Variant::ARRAY) {
+		const Array arr = p_var;
+		const int size = arr.size();
+		JSValue js_arr = JS_NewArrayWithLength(ctx, size);
+		JSValue *values = NULL;
+		uint32_t count = 0;
+		if (JS_IsException(js_arr) || !JS_GetFastArray(js_arr, &values, &count)) {
+			return js_arr;
+		}
+		// The array is not reachable from scripts yet so its storage can be filled in place
+		for (int i = 0; i < size; i++) {
+			const Variant &element = arr[i];
+			const Variant::Type type = element.get_type();
+			JSValue val;
+			if (type == Variant::ARRAY || type == Variant::DICTIONARY) {
+				val = container_to_var(ctx, element, r_state);
+			} else if (type == Variant::OBJECT && is_transferred_buffer(element)) {
+				val = transferred_to_var(ctx, element, r_state);
+			} else {
+				val = variant_to_var(ctx, element);
+			}
+			values[i] = JS_IsException(val) ? JS_UNDEFINED : val;
+		}
+		return js_arr;
+	}
+
+	const Dictionary dict = p_var;
+	JSValue obj = JS_NewObject(ctx);
+	const Variant *key = NULL;
+	while ((key = dict.next(key))) {
+		const String key_str = *key;
+		JSAtom atom;
+		if (const JSAtom *cached = r_state.key_atoms.getptr(key_str)) {
+			atom = *cached;
+		} else {
+			CharString utf8 = key_str.utf8();
+			atom = JS_NewAtomLen(ctx, utf8.get_data(), utf8.length());
+			r_state.key_atoms.set(key_str, atom);
+		}
+		const Variant &value = dict[*key];
+		const Variant::Type type = value.get_type();
+		JSValue val;
+		if (type == Variant::ARRAY || type == Variant::DICTIONARY) {
+			val = container_to_var(ctx, value, r_state);
+		} else if (type == Variant::OBJECT && is_transferred_buffer(value)) {
+			val = transferred_to_var(ctx, value, r_state);
+		} else {
+			val = variant_to_var(ctx, value);
+		}
+		JS_DefinePropertyValue(ctx, obj, atom, val, JS_PROP_C_W_E);
+	}
+	return obj;
+}
+
+// Views the transferred bytes without copying them, views of one buffer share the same ArrayBuffer
+JSValue QuickJSBinder::transferred_to_var(JSContext *ctx, Object *p_object, ContainerConversionState &r_state) {
+	QuickJSTransferredView *view = Object::cast_to<QuickJSTransferredView>(p_object);
+	QuickJSTransferredBuffer *buffer = view ? view->buffer.ptr() : Object::cast_to<QuickJSTransferredBuffer>(p_object);
+	ERR_FAIL_NULL_V(buffer, JS_UNDEFINED);
+
+	JSValue array_buffer;
+	if (const JSValue *cached = r_state.buffers.getptr(buffer)) {
+		array_buffer = JS_DupValue(ctx, *cached);
+	} else {
+		if (buffer->shared_data) {
+			array_buffer = JS_NewArrayBuffer(ctx, buffer->shared_data, buffer->shared_size, NULL, NULL, true);
+		} else if (buffer->owned_data) {
+			// Adopted once, the receiver's ArrayBuffer frees the memory
+			array_buffer = JS_NewArrayBuffer(ctx, buffer->owned_data, buffer->owned_size, QuickJSTransferredBuffer::free_owned_data, NULL, false);
+			if (!JS_IsException(array_buffer)) {
+				buffer->owned_data = NULL;
+				buffer->owned_size = 0;
+			}
+		} else {
+			array_buffer = QuickJSBuiltinBinder::new_array_buffer(ctx, buffer->storage);
+		}
+		if (JS_IsException(array_buffer)) return array_buffer;
+		r_state.buffers.set(buffer, JS_DupValue(ctx, array_buffer));
+	}
+	if (!view) return array_buffer;
+
+	JSValue global_object = JS_GetGlobalObject(ctx);
+	CharString class_name = view->class_name.utf8();
+	JSValue constructor = JS_GetPropertyStr(ctx, global_object, class_name.get_data());
+	JS_FreeValue(ctx, global_object);
+	JSValue argv[] = { array_buffer, JS_NewUint32(ctx, view->byte_offset), JS_NewUint32(ctx, view->length) };
+	JSValue ret = JS_CallConstructor(ctx, constructor, 3, argv);
+	JS_FreeValue(ctx, constructor);
+	JS_FreeValue(ctx, array_buffer);
+	return ret;
+}
+
+void QuickJSBinder::free_conversion_state(JSContext *ctx, ContainerConversionState &r_state) {
+	const String *key = NULL;
+	while ((key = r_state.key_atoms.next(key))) {
+		JS_FreeAtom(ctx, r_state.key_atoms.get(*key));
+	}
+	const void *const *buffer = NULL;
+	while ((buffer = r_state.buffers.next(buffer))) {
+		JS_FreeValue(ctx, r_state.buffers.get(*buffer));
+	}
+}
+
+// Truncates like the int conversion of Variant, NaN and out of range values are clamped so the cast is defined
+static _FORCE_INLINE_ int64_t js_double_to_int64(double p_value) {
+	if (Math::is_nan(p_value)) return 0;
+	if (p_value >= 9223372036854775807.0) return INT64_MAX;
+	if (p_value <= -9223372036854775808.0) return INT64_MIN;
+	return int64_t(p_value);
+}
+
+template <class T>
+static _FORCE_INLINE_ T js_double_to_element(double p_value) {
+	return T(js_double_to_int64(p_value));
+}
+
+template <>
+_FORCE_INLINE_ real_t js_double_to_element<real_t>(double p_value) {
+	return real_t(p_value);
+}
+
+template <class T>
+static bool js_numeric_array_to_pool(JSValueConst p_val, PoolVector<T> &r_array) {
+	JSValue *values = NULL;
+	uint32_t count = 0;
+	if (!JS_GetFastArray(p_val, &values, &count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		if (!JS_IsNumber(values[i])) {
+			return false;
+		}
+	}
+	r_array.resize(count);
+	typename PoolVector<T>::Write w = r_array.write();
+	for (uint32_t i = 0; i < count; i++) {
+		const JSValue &v = values[i];
+		w[i] = JS_VALUE_GET_TAG(v) == JS_TAG_INT ? T(JS_VALUE_GET_INT(v)) : js_double_to_element<T>(JS_VALUE_GET_FLOAT64(v));
+	}
+	return true;
+}
+
+bool QuickJSBinder::js_array_to_pool_array(JSContext *ctx, JSValueConst p_val, PoolByteArray &r_array) {
+	return js_numeric_array_to_pool(p_val, r_array);
+}
+
+bool QuickJSBinder::js_array_to_pool_array(JSContext *ctx, JSValueConst p_val, PoolIntArray &r_array) {
+	return js_numeric_array_to_pool(p_val, r_array);
+}
+
+bool QuickJSBinder::js_array_to_pool_array(JSContext *ctx, JSValueConst p_val, PoolRealArray &r_array) {
+	return js_numeric_array_to_pool(p_val, r_array);
+}
+
+bool QuickJSBinder::js_array_to_pool_variant(JSContext *ctx, JSValueConst p_val, Variant::Type p_type, Variant &r_variant) {
+	switch (p_type) {
+		case Variant::POOL_BYTE_ARRAY: {
+			PoolByteArray arr;
+			if (!js_array_to_pool_array(ctx, p_val, arr)) return false;
+			r_variant = arr;
+		} break;
+		case Variant::POOL_INT_ARRAY: {
+			PoolIntArray arr;
+			if (!js_array_to_pool_array(ctx, p_val, arr)) return false;
+			r_variant = arr;
+		} break;
+		case Variant::POOL_REAL_ARRAY: {
+			PoolRealArray arr;
+			if (!js_array_to_pool_array(ctx, p_val, arr)) return false;
+			r_variant = arr;
+		} break;
+		default:
+			return false;
+	}
+	return true;
+}
+
 JSValue QuickJSBinder::godot_builtin_function(JSContext *ctx, JSValue this_val, int argc, JSValue *argv, int magic) {
 
 	Variant ret;
@@ -461,40 +978,89 @@ String QuickJSBinder::get_backtrace_message(const List<ECMAScriptStackInfo> &sta
 	return message;
 }
 
-Dictionary QuickJSBinder::js_to_dictionary(JSContext *ctx, const JSValue &p_val, List<void *> &stack) {
+static void print_circular_reference(const String &p_path, const void *p_ptr) {
+	union {
+		const void *p;
+		uint64_t i;
+	} u;
+	u.p = p_ptr;
+	ERR_PRINTS(vformat("%s circular reference to 0x%X", p_path, u.i));
+}
+
+Dictionary QuickJSBinder::js_to_dictionary(JSContext *ctx, const JSValue &p_val, VariantConversionState &r_state) {
+	const void *ptr = JS_VALUE_GET_PTR(p_val);
+	if (r_state.share_references) {
+		if (const Variant *converted = r_state.converted.getptr(ptr)) {
+			return *converted;
+		}
+	}
+
 	Dictionary dict;
-	Set<String> keys;
-	get_own_property_names(ctx, p_val, &keys);
-	stack.push_back(JS_VALUE_GET_PTR(p_val));
-	for (Set<String>::Element *E = keys.front(); E; E = E->next()) {
-		JSValue v = JS_GetPropertyStr(ctx, p_val, E->get().utf8().get_data());
-		Variant val;
-		if (JS_IsObject(v)) {
-			void *ptr = JS_VALUE_GET_PTR(v);
-			if (stack.find(ptr)) {
-				union {
-					const void *p;
-					uint64_t i;
-				} u;
-				u.p = ptr;
-				ERR_PRINTS(vformat("Property '%s' circular reference to 0x%X", E->get(), u.i));
-				JS_FreeValue(ctx, v);
-				continue;
-			} else {
-				stack.push_back(ptr);
-				val = var_to_variant(ctx, v);
-				stack.pop_back();
-			}
+	JSPropertyEnum *props = NULL;
+	uint32_t prop_count = 0;
+	if (JS_GetOwnPropertyNames(ctx, &props, &prop_count, p_val, JS_GPN_STRING_MASK | JS_GPN_SYMBOL_MASK) < 0) {
+		JS_FreeValue(ctx, JS_GetException(ctx));
+		return dict;
+	}
+	r_state.visiting.set(ptr, true);
+	for (uint32_t i = 0; i < prop_count; i++) {
+		const JSAtom atom = props[i].atom;
+		const char *name = JS_AtomToCString(ctx, atom);
+		String key;
+		key.parse_utf8(name);
+		JS_FreeCString(ctx, name);
+
+		JSValue v = JS_GetProperty(ctx, p_val, atom);
+		if (JS_IsObject(v) && r_state.visiting.has(JS_VALUE_GET_PTR(v))) {
+			print_circular_reference(vformat("Property '%s'", key), JS_VALUE_GET_PTR(v));
 		} else {
-			val = var_to_variant(ctx, v);
+			dict[key] = var_to_variant(ctx, v, r_state);
 		}
-		dict[E->get()] = val;
 		JS_FreeValue(ctx, v);
+		JS_FreeAtom(ctx, atom);
+	}
+	js_free_rt(JS_GetRuntime(ctx), props);
+	r_state.visiting.erase(ptr);
+
+	if (r_state.share_references) {
+		r_state.converted.set(ptr, dict);
+		r_state.retained.push_back(JS_DupValue(ctx, p_val));
 	}
-	stack.pop_back();
 	return dict;
 }
 
+Array QuickJSBinder::js_to_array(JSContext *ctx, const JSValueConst &p_val, int p_length, VariantConversionState &r_state) {
+	const void *ptr = JS_VALUE_GET_PTR(p_val);
+	if (r_state.share_references) {
+		if (const Variant *converted = r_state.converted.getptr(ptr)) {
+			return *converted;
+		}
+	}
+
+	Array arr;
+	arr.resize(p_length);
+	r_state.visiting.set(ptr, true);
+	JSValue *values = NULL;
+	uint32_t count = 0;
+	for (int i = 0; i < p_length; i++) {
+		// Converting an element may run getters that reshape the array, so the storage is fetched for every element
+		JSValue val = (JS_GetFastArray(p_val, &values, &count) && uint32_t(i) < count) ? JS_DupValue(ctx, values[i]) : JS_GetPropertyUint32(ctx, p_val, i);
+		if (JS_IsObject(val) && r_state.visiting.has(JS_VALUE_GET_PTR(val))) {
+			print_circular_reference(vformat("Element %d", i), JS_VALUE_GET_PTR(val));
+		} else {
+			arr[i] = var_to_variant(ctx, val, r_state);
+		}
+		JS_FreeValue(ctx, val);
+	}
+	r_state.visiting.erase(ptr);
+
+	if (r_state.share_references) {
+		r_state.converted.set(ptr, arr);
+		r_state.retained.push_back(JS_DupValue(ctx, p_val));
+	}
+	return arr;
+}
+
 JSAtom QuickJSBinder::get_atom(JSContext *ctx, const StringName &p_key) {
 	String name = p_key;
 	CharString name_str = name.ascii();
@@ -502,6 +1068,34 @@ JSAtom QuickJSBinder::get_atom(JSContext *ctx, const StringName &p_key) {
 	return atom;
 }
 
+// The returned atom is owned by the cache and must not be freed by the caller
+JSAtom QuickJSBinder::get_cached_atom(const StringName &p_key) {
+	const void *key = p_key.data_unique_pointer();
+	if (const AtomCacheEntry *entry = atom_cache.getptr(key)) {
+		++atom_cache_hits;
+		return entry->atom;
+	}
+	++atom_cache_misses;
+	// Names built at runtime would grow the cache forever, start over once it is full
+	if (atom_cache.size() >= MAX_ATOM_CACHE_SIZE) {
+		clear_atom_cache();
+	}
+	AtomCacheEntry entry;
+	entry.name = p_key;
+	entry.atom = get_atom(ctx, p_key);
+	atom_cache.set(key, entry);
+	return entry.atom;
+}
+
+void QuickJSBinder::clear_atom_cache() {
+	const void *const *key = atom_cache.next(NULL);
+	while (key) {
+		JS_FreeAtom(ctx, atom_cache.get(*key).atom);
+		key = atom_cache.next(key);
+	}
+	atom_cache.clear();
+}
+
 JSValue QuickJSBinder::godot_to_string(JSContext *ctx, JSValue this_val, int argc, JSValue *argv) {
 	String str = var_to_variant(ctx, this_val);
 	CharString ascii = str.ascii();
@@ -573,34 +1167,8 @@ void QuickJSBinder::add_debug_binding_info(JSContext *ctx, JSValueConst p_obj, c
 	JS_DefinePropertyValueStr(ctx, p_obj, "__ctx__", ptrctx, PROP_DEF_DEFAULT);
 }
 
-static HashMap<String, String> resolve_path_cache;
-
 String QuickJSBinder::resolve_module_file(const String &file) {
-	if (const String *ptr = resolve_path_cache.getptr(file)) {
-		return *ptr;
-	}
-	String path = file;
-	if (FileAccess::exists(path)) return path;
-	// add extensions to try
-	String extension = file.get_extension();
-	List<String> extensions;
-	ECMAScriptLanguage::get_singleton()->get_recognized_extensions(&extensions);
-	if (extensions.find(extension) == NULL) {
-		for (List<String>::Element *E = extensions.front(); E; E = E->next()) {
-			path = file + "." + E->get();
-			if (FileAccess::exists(path)) {
-				return path;
-			}
-		}
-	}
-	// try index file under the folder
-	for (List<String>::Element *E = extensions.front(); E; E = E->next()) {
-		path = file + "/index." + E->get();
-		if (FileAccess::exists(path)) {
-			return path;
-		}
-	}
-	return "";
+	return QuickJSModuleResolver::resolve(file);
 }
 
 JSModuleDef *QuickJSBinder::js_module_loader(JSContext *ctx, const char *module_name, void *opaque) {
@@ -612,7 +1180,6 @@ JSModuleDef *QuickJSBinder::js_module_loader(JSContext *ctx, const char *module_
 
 	String file = resolve_module_file(resolving_file);
 	ERR_FAIL_COND_V_MSG(file.empty(), NULL, "Failed to resolve module: '" + resolving_file + "'.");
-	resolve_path_cache.set(resolving_file, file);
 
 	QuickJSBinder *binder = QuickJSBinder::get_context_binder(ctx);
 	if (ModuleCache *ptr = binder->module_cache.getptr(file)) {
@@ -622,7 +1189,21 @@ JSModuleDef *QuickJSBinder::js_module_loader(JSContext *ctx, const char *module_
 	if (!m) {
 		List<String> extensions;
 		ECMAScriptLanguage::get_singleton()->get_recognized_extensions(&extensions);
-		if (extensions.find(file.get_extension()) != NULL) {
+		uint32_t bundled_size = 0;
+		uint32_t bundled_hash = 0;
+		QuickJSModulePrefetcher::Module prefetched;
+		if (const uint8_t *bundled = ResourceFormatLoaderECMAScriptModule::get_bundled_bytecode_ptr(file, &bundled_size, &bundled_hash)) {
+			ECMAScriptGCHandler ecma;
+			if (binder->load_bytecode(bundled, bundled_size, bundled_hash, file, &ecma) == OK) {
+				m = static_cast<JSModuleDef *>(ecma.ecma_object);
+			}
+		} else if (binder->prefetch_graph && QuickJSModulePrefetcher::take(binder->prefetch_graph, file, prefetched)) {
+			binder->prefetched_modules.set(file, prefetched);
+			ECMAscriptScriptError es_err;
+			if (ModuleCache *module = binder->js_compile_and_cache_module(ctx, prefetched.source, file, &es_err)) {
+				m = module->module;
+			}
+		} else if (extensions.find(file.get_extension()) != NULL) {
 			Ref<ECMAScriptModule> em = ResourceFormatLoaderECMAScriptModule::load_static(file, "", &err);
 			if (err != OK || !em.is_valid()) {
 				JS_ThrowReferenceError(ctx, "Could not load module '%s'", file.utf8().get_data());
@@ -706,13 +1287,37 @@ QuickJSBinder::ModuleCache QuickJSBinder::js_compile_module(JSContext *ctx, cons
 	const char *cfilesource = code.get_data();
 
 	compiling_modules.push_back(p_filename);
-	JSValue func = JS_Eval(ctx, cfilesource, code.length(), cfilename, JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
+	JSValue func = JS_UNDEFINED;
+	bool from_cache = false;
+	if (QuickJSModulePrefetcher::Module *prefetched = prefetched_modules.getptr(p_filename)) {
+		if (prefetched->source == p_code) {
+			func = read_compiled_module(ctx, prefetched->bytecode);
+			// The prefetcher already stored it in the bytecode cache
+			from_cache = !JS_IsUndefined(func);
+		}
+		prefetched_modules.erase(p_filename);
+	}
+	Vector<uint8_t> cached_bytecode;
+	if (!from_cache && bytecode_cache_enabled && QuickJSBytecodeCache::load(p_filename, p_code, cached_bytecode) == OK) {
+		func = read_compiled_module(ctx, cached_bytecode);
+		from_cache = !JS_IsUndefined(func);
+	}
+	if (!from_cache) {
+		func = JS_Eval(ctx, cfilesource, code.length(), cfilename, JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY | JS_EVAL_FLAG_NO_RESOLVE);
+	}
 	compiling_modules.pop_back();
 
 	if (!JS_IsException(func)) {
 		module.flags = MODULE_FLAG_SCRIPT;
 		module.module = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(func));
 		module.res_value = JS_UNDEFINED;
+		if (bytecode_cache_enabled && !from_cache) {
+			size_t size;
+			if (uint8_t *buf = JS_WriteObject(ctx, &size, func, JS_WRITE_OBJ_BYTECODE | JS_WRITE_OBJ_REFERENCE | JS_WRITE_OBJ_SAB)) {
+				QuickJSBytecodeCache::save(p_filename, p_code, buf, size);
+				js_free(ctx, buf);
+			}
+		}
 	} else {
 		JSValue e = JS_GetException(ctx);
 		dump_exception(ctx, e, r_error);
@@ -722,6 +1327,18 @@ QuickJSBinder::ModuleCache QuickJSBinder::js_compile_module(JSContext *ctx, cons
 	return module;
 }
 
+// Returns JS_UNDEFINED when the bytecode can't be read so the caller can compile from source instead
+JSValue QuickJSBinder::read_compiled_module(JSContext *ctx, const Vector<uint8_t> &p_bytecode) {
+	JSValue func = JS_ReadObject(ctx, p_bytecode.ptr(), p_bytecode.size(), JS_READ_OBJ_BYTECODE | JS_READ_OBJ_REFERENCE | JS_READ_OBJ_SAB);
+	if (JS_VALUE_GET_TAG(func) != JS_TAG_MODULE) {
+		JS_FreeValue(ctx, func);
+		JS_FreeValue(ctx, JS_GetException(ctx));
+		return JS_UNDEFINED;
+	}
+	// Linked by js_compile_and_cache_module once the module is cached so cyclic imports find it
+	return func;
+}
+
 QuickJSBinder::ModuleCache *QuickJSBinder::js_compile_and_cache_module(JSContext *ctx, const String &p_code, const String &p_filename, ECMAscriptScriptError *r_error) {
 
 	QuickJSBinder *binder = QuickJSBinder::get_context_binder(ctx);
@@ -750,6 +1367,30 @@ QuickJSBinder::ModuleCache *QuickJSBinder::js_compile_and_cache_module(JSContext
 	mc.hash = p_code.hash();
 	if (mc.module) {
 		binder->module_cache.set(p_filename, mc);
+		// Compile the uncached static imports on worker threads while the module is linked
+		bool started_prefetch = false;
+		if (binder->module_prefetch_enabled && binder->prefetch_graph == NULL && JS_GetModuleRequestCount(mc.module) > 0) {
+			List<String> imports;
+			get_module_imports(ctx, mc.module, &imports);
+			List<String> dependencies;
+			QuickJSModulePrefetcher::resolve_imports(p_filename, imports, &dependencies);
+			binder->prefetch_graph = QuickJSModulePrefetcher::prefetch(binder, p_filename, dependencies);
+			started_prefetch = binder->prefetch_graph != NULL;
+		}
+		const bool resolved = JS_ResolveModule(ctx, JS_MKPTR(JS_TAG_MODULE, mc.module)) >= 0;
+		if (started_prefetch) {
+			QuickJSModulePrefetcher::release(binder->prefetch_graph);
+			binder->prefetch_graph = NULL;
+			binder->prefetched_modules.clear();
+		}
+		if (!resolved) {
+			// Unresolved modules are freed by QuickJS on failure
+			binder->module_cache.erase(p_filename);
+			JSValue e = JS_GetException(ctx);
+			dump_exception(ctx, e, r_error);
+			JS_Throw(ctx, e);
+			return NULL;
+		}
 	}
 	return binder->module_cache.getptr(p_filename);
 }
@@ -795,50 +1436,33 @@ int QuickJSBinder::resource_module_initializer(JSContext *ctx, JSModuleDef *m) {
 	return JS_SetModuleExport(ctx, m, "default", JS_UNDEFINED);
 }
 
-JSClassID QuickJSBinder::register_class(const ClassDB::ClassInfo *p_cls) {
+JSClassID QuickJSBinder::register_class(const QuickJSClassTable::Class &p_cls) {
 
 	ClassBindData data;
-	data.class_id = 0;
+	data.class_id = p_cls.class_id;
 	data.base_class = NULL;
-
-	if (class_remap.has(p_cls->name)) {
-		data.class_name = class_remap[p_cls->name];
-		data.jsclass.class_name = class_remap[p_cls->name];
-		if (data.jsclass.class_name == "") {
-			return 0;
-		}
-	} else {
-		data.class_name = String(p_cls->name).ascii();
-		data.jsclass.class_name = data.class_name.get_data();
-	}
-
+	data.class_name = p_cls.name;
+	data.jsclass.class_name = data.class_name.get_data();
 	data.jsclass.exotic = NULL;
 	data.jsclass.gc_mark = NULL;
 	data.jsclass.call = NULL;
-	data.gdclass = p_cls;
+	data.gdclass = p_cls.gdclass;
 
 	data.prototype = JS_NewObject(ctx);
 
 	// methods
-	Map<StringName, JSValue> methods;
+	Vector<JSValue> methods;
 	{
-		godot_methods.resize(internal_godot_method_id + p_cls->method_map.size());
-		const StringName *key = p_cls->method_map.next(NULL);
-		while (key) {
-			MethodBind *mb = p_cls->method_map.get(*key);
-			godot_methods.write[internal_godot_method_id] = mb;
-
-			CharString name = String(*key).ascii();
-			JSValue method = JS_NewCFunctionMagic(ctx, &QuickJSBinder::object_method, name.get_data(), mb->get_argument_count(), JS_CFUNC_generic_magic, internal_godot_method_id);
-			JS_DefinePropertyValueStr(ctx, data.prototype, name.get_data(), method, PROP_DEF_DEFAULT);
-
-			methods.insert(*key, method);
-
-			++internal_godot_method_id;
-			key = p_cls->method_map.next(key);
+		methods.resize(p_cls.method_count);
+		for (int i = 0; i < p_cls.method_count; i++) {
+			const int method_id = p_cls.method_begin + i;
+			const QuickJSClassTable::Method &method = class_table->methods[method_id];
+			JSValue func = JS_NewCFunctionMagic(ctx, &QuickJSBinder::object_method, method.name.get_data(), method.bind->get_argument_count(), JS_CFUNC_generic_magic, method_id);
+			JS_DefinePropertyValueStr(ctx, data.prototype, method.name.get_data(), func, PROP_DEF_DEFAULT);
+			methods.write[i] = func;
 		}
 
-		if (p_cls->name == "Object") {
+		if (p_cls.gdclass->name == "Object") {
 			// toString()
 			JSValue to_string_func = JS_NewCFunction(ctx, godot_to_string, TO_STRING_LITERAL, 0);
 			JS_DefinePropertyValueStr(ctx, data.prototype, TO_STRING_LITERAL, to_string_func, PROP_DEF_DEFAULT);
@@ -850,61 +1474,37 @@ JSClassID QuickJSBinder::register_class(const ClassDB::ClassInfo *p_cls) {
 	}
 
 	// properties
-	{
-		const StringName *key = p_cls->property_setget.next(NULL);
-		while (key) {
-			const StringName &prop_name = *key;
-			const ClassDB::PropertySetGet &prop = p_cls->property_setget[prop_name];
-
-			JSValue setter = JS_UNDEFINED;
-			JSValue getter = JS_UNDEFINED;
-
-			if (prop.index >= 0) {
-				int size = godot_object_indexed_properties.size();
-				if (size <= internal_godot_indexed_property_id) {
-					godot_object_indexed_properties.resize(size + 128);
-				}
-				godot_object_indexed_properties.write[internal_godot_indexed_property_id] = &prop;
-				CharString name = String(*key).ascii();
-				getter = JS_NewCFunctionMagic(ctx, &QuickJSBinder::object_indexed_property, name.get_data(), 0, JS_CFUNC_generic_magic, internal_godot_indexed_property_id);
-				setter = JS_NewCFunctionMagic(ctx, &QuickJSBinder::object_indexed_property, name.get_data(), 1, JS_CFUNC_generic_magic, internal_godot_indexed_property_id);
-				++internal_godot_indexed_property_id;
-			} else {
-				if (Map<StringName, JSValue>::Element *E = methods.find(prop.setter)) {
-					setter = E->get();
-					JS_DupValue(ctx, setter);
-				} else if (MethodBind *mb = prop._setptr) {
-					if (godot_methods.size() >= internal_godot_method_id) {
-						godot_methods.resize(godot_methods.size() + 1);
-					}
-					godot_methods.write[internal_godot_method_id] = mb;
-					String setter_name = prop.setter;
-					setter = JS_NewCFunctionMagic(ctx, &QuickJSBinder::object_method, setter_name.ascii().get_data(), mb->get_argument_count(), JS_CFUNC_generic_magic, internal_godot_method_id);
-					++internal_godot_method_id;
-				}
+	for (int i = 0; i < p_cls.property_count; i++) {
+		const QuickJSClassTable::Property &prop = class_table->properties[p_cls.property_begin + i];
 
-				if (Map<StringName, JSValue>::Element *E = methods.find(prop.getter)) {
-					getter = E->get();
-					JS_DupValue(ctx, getter);
-				} else if (MethodBind *mb = prop._getptr) {
-					if (godot_methods.size() >= internal_godot_method_id) {
-						godot_methods.resize(godot_methods.size() + 1);
-					}
-					godot_methods.write[internal_godot_method_id] = mb;
-					String getter_name = prop.getter;
-					getter = JS_NewCFunctionMagic(ctx, &QuickJSBinder::object_method, getter_name.ascii().get_data(), mb->get_argument_count(), JS_CFUNC_generic_magic, internal_godot_method_id);
-					++internal_godot_method_id;
+		JSValue setter = JS_UNDEFINED;
+		JSValue getter = JS_UNDEFINED;
+
+		if (prop.indexed >= 0) {
+			CharString name = String(prop.name).ascii();
+			getter = JS_NewCFunctionMagic(ctx, &QuickJSBinder::object_indexed_property, name.get_data(), 0, JS_CFUNC_generic_magic, prop.indexed);
+			setter = JS_NewCFunctionMagic(ctx, &QuickJSBinder::object_indexed_property, name.get_data(), 1, JS_CFUNC_generic_magic, prop.indexed);
+		} else {
+			const int accessor_ids[2] = { prop.getter, prop.setter };
+			JSValue *accessors[2] = { &getter, &setter };
+			for (int j = 0; j < 2; j++) {
+				const int method_id = accessor_ids[j];
+				if (method_id < 0) continue;
+				// Reuse the prototype method when the accessor is one of the class methods
+				if (method_id >= p_cls.method_begin && method_id < p_cls.method_begin + p_cls.method_count) {
+					*accessors[j] = JS_DupValue(ctx, methods[method_id - p_cls.method_begin]);
+				} else {
+					const QuickJSClassTable::Method &method = class_table->methods[method_id];
+					*accessors[j] = JS_NewCFunctionMagic(ctx, &QuickJSBinder::object_method, method.name.get_data(), method.bind->get_argument_count(), JS_CFUNC_generic_magic, method_id);
 				}
 			}
-
-			JSAtom atom = get_atom(ctx, prop_name);
-			JS_DefinePropertyGetSet(ctx, data.prototype, atom, getter, setter, PROP_DEF_DEFAULT);
-			JS_FreeAtom(ctx, atom);
-			key = p_cls->property_setget.next(key);
 		}
+
+		JSAtom atom = get_atom(ctx, prop.name);
+		JS_DefinePropertyGetSet(ctx, data.prototype, atom, getter, setter, PROP_DEF_DEFAULT);
+		JS_FreeAtom(ctx, atom);
 	}
 
-	JS_NewClassID(&data.class_id);
 	JS_NewClass(JS_GetRuntime(ctx), data.class_id, &data.jsclass);
 	JS_SetClassProto(ctx, data.class_id, data.prototype);
 
@@ -914,57 +1514,38 @@ JSClassID QuickJSBinder::register_class(const ClassDB::ClassInfo *p_cls) {
 	JS_DefinePropertyValue(ctx, data.constructor, js_key_godot_classid, JS_NewInt32(ctx, data.class_id), PROP_DEF_DEFAULT);
 
 	// constants
-	{
-		const StringName *key = p_cls->constant_map.next(NULL);
-		while (key) {
-
-			int value = p_cls->constant_map.get(*key);
-			JSAtom atom = get_atom(ctx, *key);
-			JS_DefinePropertyValue(ctx, data.constructor, atom, JS_NewInt32(ctx, value), PROP_DEF_DEFAULT);
-			JS_FreeAtom(ctx, atom);
-
-			key = p_cls->constant_map.next(key);
-		}
+	for (int i = 0; i < p_cls.constant_count; i++) {
+		const QuickJSClassTable::Constant &constant = class_table->constants[p_cls.constant_begin + i];
+		JSAtom atom = get_atom(ctx, constant.name);
+		JS_DefinePropertyValue(ctx, data.constructor, atom, JS_NewInt32(ctx, constant.value), PROP_DEF_DEFAULT);
+		JS_FreeAtom(ctx, atom);
 	}
 
 	// enumeration
-	{
-		const StringName *key = p_cls->enum_map.next(NULL);
-		while (key) {
-
-			JSValue enum_obj = JS_NewObject(ctx);
-			JSAtom atom = get_atom(ctx, *key);
-
-			const List<StringName> &const_keys = p_cls->enum_map.get(*key);
-			for (const List<StringName>::Element *E = const_keys.front(); E; E = E->next()) {
-				int value = p_cls->constant_map.get(E->get());
-				JSAtom atom_key = get_atom(ctx, E->get());
-				JS_DefinePropertyValue(ctx, enum_obj, atom_key, JS_NewInt32(ctx, value), PROP_DEF_DEFAULT);
-				JS_FreeAtom(ctx, atom_key);
-			}
-
-			JS_DefinePropertyValue(ctx, data.constructor, atom, enum_obj, PROP_DEF_DEFAULT);
-			JS_FreeAtom(ctx, atom);
-
-			key = p_cls->enum_map.next(key);
+	for (int i = 0; i < p_cls.enum_count; i++) {
+		const QuickJSClassTable::Enum &enumeration = class_table->enums[p_cls.enum_begin + i];
+		JSValue enum_obj = JS_NewObject(ctx);
+		for (int j = 0; j < enumeration.constant_count; j++) {
+			const QuickJSClassTable::Constant &constant = class_table->enum_constants[enumeration.constant_begin + j];
+			JSAtom atom_key = get_atom(ctx, constant.name);
+			JS_DefinePropertyValue(ctx, enum_obj, atom_key, JS_NewInt32(ctx, constant.value), PROP_DEF_DEFAULT);
+			JS_FreeAtom(ctx, atom_key);
 		}
+		JSAtom atom = get_atom(ctx, enumeration.name);
+		JS_DefinePropertyValue(ctx, data.constructor, atom, enum_obj, PROP_DEF_DEFAULT);
+		JS_FreeAtom(ctx, atom);
 	}
 
 	// signals
-	{
-		const StringName *key = p_cls->signal_map.next(NULL);
-		while (key) {
-
-			JSAtom atom = get_atom(ctx, *key);
-			JS_DefinePropertyValue(ctx, data.constructor, atom, to_js_string(ctx, *key), PROP_DEF_DEFAULT);
-			JS_FreeAtom(ctx, atom);
-
-			key = p_cls->signal_map.next(key);
-		}
+	for (int i = 0; i < p_cls.signal_count; i++) {
+		const StringName &signal = class_table->signals[p_cls.signal_begin + i];
+		JSAtom atom = get_atom(ctx, signal);
+		JS_DefinePropertyValue(ctx, data.constructor, atom, to_js_string(ctx, signal), PROP_DEF_DEFAULT);
+		JS_FreeAtom(ctx, atom);
 	}
 
 	class_bindings.set(data.class_id, data);
-	classname_bindings.set(p_cls->name, class_bindings.getptr(data.class_id));
+	classname_bindings.set(p_cls.gdclass->name, class_bindings.getptr(data.class_id));
 
 	return data.class_id;
 }
@@ -989,51 +1570,46 @@ void QuickJSBinder::add_godot_origin() {
 }
 
 void QuickJSBinder::add_godot_classes() {
-
-	Map<const ClassDB::ClassInfo *, JSClassID> gdclass_jsmap;
-	// register classes
-	const StringName *key = ClassDB::classes.next(NULL);
-	while (key) {
-		const ClassDB::ClassInfo *cls = ClassDB::classes.getptr(*key);
-		if (JSClassID id = register_class(cls)) {
-			gdclass_jsmap.insert(cls, id);
-		}
-		key = ClassDB::classes.next(key);
+	// godot.X builds the class binding on first access, only the roots are bound eagerly
+	for (int i = 0; i < class_table->classes.size(); i++) {
+		const QuickJSClassTable::Class &cls = class_table->classes[i];
+		JSValue getter = JS_NewCFunctionMagic(ctx, godot_class_getter, cls.name.get_data(), 0, JS_CFUNC_generic_magic, i);
+		JSAtom atom = JS_NewAtom(ctx, cls.name.get_data());
+		JS_DefinePropertyGetSet(ctx, godot_object, atom, getter, JS_UNDEFINED, PROP_DEF_DEFAULT);
+		JS_FreeAtom(ctx, atom);
 	}
+	godot_object_class = get_class_binding("Object");
+	godot_reference_class = get_class_binding("Reference");
+}
 
-	// Setup inherits chain
-	for (Map<const ClassDB::ClassInfo *, JSClassID>::Element *E = gdclass_jsmap.front(); E; E = E->next()) {
-		const ClassDB::ClassInfo *gdcls = E->key();
-		ClassBindData &bind = class_bindings.get(E->get());
-		if (gdcls->inherits_ptr) {
-			if (Map<const ClassDB::ClassInfo *, JSClassID>::Element *base = gdclass_jsmap.find(gdcls->inherits_ptr)) {
-				bind.base_class = class_bindings.getptr(base->get());
-			}
-		}
+const QuickJSBinder::ClassBindData *QuickJSBinder::get_class_binding(const StringName &p_class) {
+	if (const ClassBindData **bind = classname_bindings.getptr(p_class)) {
+		return *bind;
 	}
+	const int *index = class_table->class_indices.getptr(p_class);
+	return index ? get_class_binding(*index) : NULL;
+}
 
-	// Setup the prototype chain
-	const JSClassID *id = class_bindings.next(NULL);
-	while (id) {
-
-		const ClassBindData &data = class_bindings.get(*id);
-
-		int flags = PROP_DEF_DEFAULT;
-		// Allows redefine as to global object
-		if (Engine::get_singleton()->has_singleton(data.gdclass->name)) {
-			flags |= JS_PROP_CONFIGURABLE;
-		}
-		JS_DefinePropertyValueStr(ctx, godot_object, data.jsclass.class_name, data.constructor, flags);
-		if (data.base_class) {
-			JS_SetPrototype(ctx, data.prototype, data.base_class->prototype);
-		} else {
-			JS_SetPrototype(ctx, data.prototype, godot_origin_class.prototype);
-		}
-
-		id = class_bindings.next(id);
+const QuickJSBinder::ClassBindData *QuickJSBinder::get_class_binding(int p_index) {
+	const QuickJSClassTable::Class &cls = class_table->classes[p_index];
+	if (const ClassBindData **bind = classname_bindings.getptr(cls.gdclass->name)) {
+		return *bind;
 	}
-	godot_object_class = *classname_bindings.getptr("Object");
-	godot_reference_class = *classname_bindings.getptr("Reference");
+	// Base classes are bound first so the prototype chain is complete
+	const ClassBindData *base = cls.base >= 0 ? get_class_binding(cls.base) : NULL;
+	ClassBindData &bind = class_bindings.get(register_class(cls));
+	bind.base_class = base;
+	JS_SetPrototype(ctx, bind.prototype, base ? base->prototype : godot_origin_class.prototype);
+	return &bind;
+}
+
+JSValue QuickJSBinder::godot_class_getter(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv, int magic) {
+	QuickJSBinder *binder = get_context_binder(ctx);
+	ERR_FAIL_INDEX_V(magic, binder->class_table->classes.size(), JS_UNDEFINED);
+	const ClassBindData *bind = binder->get_class_binding(magic);
+	// Replace the accessor so later lookups are plain property reads
+	JS_DefinePropertyValueStr(ctx, binder->godot_object, bind->jsclass.class_name, JS_DupValue(ctx, bind->constructor), PROP_DEF_DEFAULT);
+	return JS_DupValue(ctx, bind->constructor);
 }
 
 void QuickJSBinder::add_godot_globals() {
@@ -1045,9 +1621,8 @@ void QuickJSBinder::add_godot_globals() {
 
 		ERR_CONTINUE(s.ptr == NULL);
 
-		const ClassBindData **cls_ptr = classname_bindings.getptr(s.ptr->get_class_name());
-		ERR_CONTINUE(cls_ptr == NULL);
-		const ClassBindData *cls = *cls_ptr;
+		const ClassBindData *cls = get_class_binding(s.ptr->get_class_name());
+		ERR_CONTINUE(cls == NULL);
 
 		JSValue obj = JS_NewObjectProtoClass(ctx, cls->prototype, get_origin_class_id());
 		ECMAScriptGCHandler *data = new_gc_handler(ctx);
@@ -1193,6 +1768,12 @@ void QuickJSBinder::add_godot_globals() {
 	// godot.adopt_value
 	JSValue adopt_value_func = JS_NewCFunction(ctx, godot_adopt_value, "adopt_value", 1);
 	JS_DefinePropertyValueStr(ctx, godot_object, "adopt_value", adopt_value_func, PROP_DEF_DEFAULT);
+	// godot.set_job_budget
+	JSValue set_job_budget_func = JS_NewCFunction(ctx, godot_set_job_budget, "set_job_budget", 2);
+	JS_DefinePropertyValueStr(ctx, godot_object, "set_job_budget", set_job_budget_func, PROP_DEF_DEFAULT);
+	// godot.get_job_stats
+	JSValue get_job_stats_func = JS_NewCFunction(ctx, godot_get_job_stats, "get_job_stats", 0);
+	JS_DefinePropertyValueStr(ctx, godot_object, "get_job_stats", get_job_stats_func, PROP_DEF_DEFAULT);
 
 	{
 		// godot.DEBUG_ENABLED
@@ -1212,14 +1793,19 @@ void QuickJSBinder::add_godot_globals() {
 
 QuickJSBinder::QuickJSBinder() {
 	context_id = global_context_id++;
-	internal_godot_method_id = 0;
-	internal_godot_indexed_property_id = 0;
+	class_table = NULL;
 	godot_allocator.js_malloc = QuickJSBinder::js_binder_malloc;
 	godot_allocator.js_free = QuickJSBinder::js_binder_free;
 	godot_allocator.js_realloc = QuickJSBinder::js_binder_realloc;
 	godot_allocator.js_malloc_usable_size = NULL;
 	godot_object_class = NULL;
 	godot_reference_class = NULL;
+	atom_cache_hits = 0;
+	atom_cache_misses = 0;
+	share_converted_references = false;
+	bytecode_cache_enabled = false;
+	module_prefetch_enabled = false;
+	prefetch_graph = NULL;
 
 	if (class_remap.empty()) {
 		class_remap.insert(_File::get_class_static(), "File");
@@ -1227,6 +1813,8 @@ QuickJSBinder::QuickJSBinder() {
 		class_remap.insert(_Thread::get_class_static(), "");
 		class_remap.insert(_Mutex::get_class_static(), "");
 		class_remap.insert(_Semaphore::get_class_static(), "");
+		class_remap.insert(QuickJSTransferredBuffer::get_class_static(), "");
+		class_remap.insert(QuickJSTransferredView::get_class_static(), "");
 	}
 }
 
@@ -1235,19 +1823,25 @@ QuickJSBinder::~QuickJSBinder() {
 
 void QuickJSBinder::initialize() {
 
-	thread_id = Thread::get_caller_id();
-	{
-		GLOBAL_LOCK_FUNCTION
-		ECMAScriptLanguage::get_singleton()->thread_binder_map.set(thread_id, this);
-	}
+	bind_thread();
 
 	// create runtime and context for the binder
+	share_converted_references = GLOBAL_DEF("JavaScript/conversion/share_object_references", false);
+	bytecode_cache_enabled = GLOBAL_DEF("JavaScript/bytecode_cache/enabled", true);
+	module_prefetch_enabled = GLOBAL_DEF("JavaScript/module_prefetch/enabled", false);
+	timer_frame_budget_usec = MAX(int(GLOBAL_DEF("JavaScript/timers/frame_budget_usec", 0)), 0);
+	job_frame_budget_usec = MAX(int(GLOBAL_DEF("JavaScript/jobs/frame_budget_usec", 0)), 0);
+	job_frame_max_count = MAX(int(GLOBAL_DEF("JavaScript/jobs/max_jobs_per_frame", 0)), 0);
+
 	runtime = JS_NewRuntime2(&godot_allocator, this);
 	ctx = JS_NewContext(runtime);
 	JS_AddIntrinsicOperators(ctx);
 
 	JS_SetModuleLoaderFunc(runtime, /*js_module_resolve*/ NULL, js_module_loader, this);
 	JS_SetContextOpaque(ctx, this);
+	// SharedArrayBuffers can be posted to workers, no runtime may block in Atomics.wait
+	JS_SetSharedArrayBufferFunctions(runtime, &QuickJSSharedMemory::functions);
+	JS_SetCanBlock(runtime, false);
 
 	empty_function = JS_NewCFunction(ctx, js_empty_func, "virtual_fuction", 0);
 	// global = globalThis
@@ -1269,6 +1863,7 @@ void QuickJSBinder::initialize() {
 	// godot.Vector2 godot.Color ...
 	builtin_binder.initialize(ctx, this);
 	// godot.Object godot.Node godot.Theme ...
+	class_table = QuickJSClassTable::acquire(class_remap);
 	add_godot_classes();
 	// godot.print godot.sin ...
 	add_godot_globals();
@@ -1281,7 +1876,7 @@ void QuickJSBinder::initialize() {
 	// binding script
 	String script_binding_error;
 	ECMAScriptGCHandler eval_ret;
-	if (OK == safe_eval_text(ECMAScriptBinder::BINDING_SCRIPT_CONTENT, ECMAScriptBinder::EVAL_TYPE_GLOBAL, "<internal: binding_script.js>", script_binding_error, eval_ret)) {
+	if (OK == eval_binding_script(script_binding_error, eval_ret)) {
 #ifdef TOOLS_ENABLED
 		JSValue ret = JS_MKPTR(JS_TAG_OBJECT, eval_ret.ecma_object);
 		modified_api = var_to_variant(ctx, ret);
@@ -1376,6 +1971,15 @@ void QuickJSBinder::uninitialize() {
 	}
 	frame_callbacks.clear();
 
+	// Free timers
+	const int64_t *timer_id = timers.next(NULL);
+	while (timer_id) {
+		free_timer(timers.get(*timer_id));
+		timer_id = timers.next(timer_id);
+	}
+	timers.clear();
+	timer_queue.clear();
+
 	List<RES> module_resources;
 	{ // modules
 		const String *file = module_cache.next(NULL);
@@ -1408,12 +2012,25 @@ void QuickJSBinder::uninitialize() {
 		commonjs_module_cache.clear();
 	}
 
+	// Each bound class holds a reference to its constructor
+	const JSClassID *class_id = class_bindings.next(NULL);
+	while (class_id) {
+		JS_FreeValue(ctx, class_bindings.get(*class_id).constructor);
+		class_id = class_bindings.next(class_id);
+	}
+	class_bindings.clear();
+	classname_bindings.clear();
+	QuickJSClassTable::release();
+	class_table = NULL;
+
 	JS_FreeAtom(ctx, js_key_godot_classid);
 	JS_FreeAtom(ctx, js_key_godot_classname);
 	JS_FreeAtom(ctx, js_key_godot_tooled);
 	JS_FreeAtom(ctx, js_key_godot_icon_path);
 	JS_FreeAtom(ctx, js_key_godot_exports);
 	JS_FreeAtom(ctx, js_key_godot_signals);
+	print_verbose(vformat("ECMAScript context %d atom cache: %d hits, %d misses", context_id, atom_cache_hits, atom_cache_misses));
+	clear_atom_cache();
 	JS_FreeValue(ctx, js_operators);
 	JS_FreeValue(ctx, js_operators_create);
 	JS_FreeValue(ctx, empty_function);
@@ -1423,6 +2040,13 @@ void QuickJSBinder::uninitialize() {
 	JS_SetContextOpaque(ctx, NULL);
 	JS_FreeContext(ctx);
 	JS_FreeRuntime(runtime);
+	// All builtin values are finalized with the runtime
+	builtin_binder.release_pools();
+	if (prefetch_graph) {
+		QuickJSModulePrefetcher::release(prefetch_graph);
+		prefetch_graph = NULL;
+	}
+	prefetched_modules.clear();
 
 	for (List<RES>::Element *E = module_resources.front(); E; E = E->next()) {
 		E->get()->unreference(); // Avoid imported resource leaking
@@ -1435,34 +2059,52 @@ void QuickJSBinder::uninitialize() {
 	ctx = NULL;
 	runtime = NULL;
 
-	{
-		GLOBAL_LOCK_FUNCTION
+	unbind_thread();
+}
+
+void QuickJSBinder::bind_thread() {
+	thread_id = Thread::get_caller_id();
+	GLOBAL_LOCK_FUNCTION
+	ECMAScriptLanguage::get_singleton()->thread_binder_map.set(thread_id, this);
+}
+
+void QuickJSBinder::unbind_thread() {
+	GLOBAL_LOCK_FUNCTION
+	ECMAScriptBinder **ptr = ECMAScriptLanguage::get_singleton()->thread_binder_map.getptr(thread_id);
+	if (ptr && *ptr == this) {
 		ECMAScriptLanguage::get_singleton()->thread_binder_map.erase(thread_id);
 	}
 }
 
+void QuickJSBinder::initialize_globals() {
+	binding_script_mutex = Mutex::create();
+	QuickJSClassTable::initialize();
+	QuickJSModuleResolver::initialize();
+	QuickJSModulePrefetcher::initialize();
+	QuickJSWorkerPool::initialize();
+}
+
+void QuickJSBinder::finalize_globals() {
+	QuickJSWorkerPool::finalize();
+	QuickJSModulePrefetcher::finalize();
+	QuickJSModuleResolver::finalize();
+	QuickJSClassTable::finalize();
+	memdelete(binding_script_mutex);
+	binding_script_mutex = NULL;
+	binding_script_bytecode.clear();
+}
+
 void QuickJSBinder::language_finalize() {
 
+	QuickJSModulePrefetcher::finish();
+
 	GLOBAL_LOCK_FUNCTION
 	transfer_deopot.clear();
 }
 
 void QuickJSBinder::frame() {
-	JSContext *ctx1;
-	int err;
-	for (;;) {
-		err = JS_ExecutePendingJob(JS_GetRuntime(ctx), &ctx1);
-		if (err <= 0) {
-			if (err < 0) {
-				ECMAscriptScriptError script_err;
-				JSValue e = JS_GetException(ctx1);
-				dump_exception(ctx1, e, &script_err);
-				ERR_PRINTS(error_to_string(script_err));
-				JS_FreeValue(ctx1, e);
-			}
-			break;
-		}
-	}
+	fire_timers();
+	run_pending_jobs();
 
 	for (List<ECMAScriptGCHandler *>::Element *E = workers.front(); E; E = E->next()) {
 		ECMAScriptGCHandler *bind = E->get();
@@ -1494,6 +2136,98 @@ void QuickJSBinder::frame() {
 #endif
 }
 
+// Runs the promise jobs until the queue is empty or the frame budget is spent, the rest run next frame
+void QuickJSBinder::run_pending_jobs() {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	JSContext *ctx1;
+	int err;
+	int count = 0;
+	int pending = 0;
+	for (;;) {
+		if ((job_frame_max_count && count >= job_frame_max_count) || (job_frame_budget_usec && OS::get_singleton()->get_ticks_usec() - begin >= job_frame_budget_usec)) {
+			pending = JS_GetPendingJobCount(runtime);
+			if (pending) {
+				// Jobs are run in order, the ones deferred by the last frame that did not run yet were already counted
+				jobs_deferred += pending - MAX(job_carried_over - count, 0);
+				job_frames_deferred++;
+			}
+			break;
+		}
+		err = JS_ExecutePendingJob(runtime, &ctx1);
+		if (err <= 0) {
+			if (err < 0) {
+				ECMAscriptScriptError script_err;
+				JSValue e = JS_GetException(ctx1);
+				dump_exception(ctx1, e, &script_err);
+				ERR_PRINTS(error_to_string(script_err));
+				JS_FreeValue(ctx1, e);
+				count++;
+			}
+			break;
+		}
+		count++;
+	}
+	job_carried_over = pending;
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+	jobs_run += count;
+	job_time_usec += elapsed;
+	job_max_frame_time_usec = MAX(job_max_frame_time_usec, elapsed);
+}
+
+uint64_t QuickJSBinder::get_timer_deadline(uint64_t p_delay_usec) const {
+	const uint64_t deadline = OS::get_singleton()->get_ticks_usec() + p_delay_usec;
+	return timer_fire_time ? MAX(deadline, timer_fire_time + 1) : deadline;
+}
+
+void QuickJSBinder::free_timer(Timer &p_timer) {
+	JS_FreeValue(ctx, p_timer.callback);
+	for (int i = 0; i < p_timer.arguments.size(); i++) {
+		JS_FreeValue(ctx, p_timer.arguments[i]);
+	}
+}
+
+// Fires the expired timers in deadline order until the frame budget is spent
+void QuickJSBinder::fire_timers() {
+	if (timer_queue.empty()) return;
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	timer_fire_time = begin;
+
+	QuickJSTimerQueue::Entry entry;
+	while (!timer_queue.empty() && timer_queue.top().time <= begin) {
+		timer_queue.pop(entry);
+		Timer *timer = timers.getptr(entry.id);
+		ERR_CONTINUE(timer == NULL);
+
+		// The callback may clear its own timer
+		Timer call = *timer;
+		if (timer->repeat) {
+			JS_DupValue(ctx, call.callback);
+			for (int i = 0; i < call.arguments.size(); i++) {
+				JS_DupValue(ctx, call.arguments[i]);
+			}
+			timer_queue.push(get_timer_deadline(timer->interval), entry.id);
+		} else {
+			timers.erase(entry.id);
+		}
+
+		JSValue ret = JS_Call(ctx, call.callback, global_object, call.arguments.size(), call.arguments.ptrw());
+		if (JS_IsException(ret)) {
+			JSValue e = JS_GetException(ctx);
+			ECMAscriptScriptError err;
+			dump_exception(ctx, e, &err);
+			ERR_PRINTS("Error in timer callback:" ENDL + error_to_string(err));
+			JS_FreeValue(ctx, e);
+		}
+		JS_FreeValue(ctx, ret);
+		free_timer(call);
+
+		if (timer_frame_budget_usec && OS::get_singleton()->get_ticks_usec() - begin >= timer_frame_budget_usec) {
+			break;
+		}
+	}
+	timer_fire_time = 0;
+}
+
 Error QuickJSBinder::eval_string(const String &p_source, EvalType type, const String &p_path, ECMAScriptGCHandler &r_ret) {
 	String error;
 	Error err = safe_eval_text(p_source, type, p_path, error, r_ret);
@@ -1527,6 +2261,83 @@ Error QuickJSBinder::safe_eval_text(const String &p_source, EvalType type, const
 	}
 	return OK;
 }
+
+Error QuickJSBinder::compile_binding_script(const char *p_filename, String &r_error) {
+	CharString code = BINDING_SCRIPT_CONTENT.utf8();
+	JSValue func = JS_Eval(ctx, code.get_data(), code.length(), p_filename, JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_STRICT | JS_EVAL_FLAG_COMPILE_ONLY);
+	if (JS_IsException(func)) {
+		JSValue e = JS_GetException(ctx);
+		ECMAscriptScriptError err;
+		dump_exception(ctx, e, &err);
+		r_error = error_to_string(err);
+		JS_FreeValue(ctx, e);
+		return ERR_PARSE_ERROR;
+	}
+	size_t size;
+	uint8_t *buf = JS_WriteObject(ctx, &size, func, JS_WRITE_OBJ_BYTECODE);
+	JS_FreeValue(ctx, func);
+	ERR_FAIL_COND_V(buf == NULL, ERR_PARSE_ERROR);
+	binding_script_bytecode.resize(size);
+	copymem(binding_script_bytecode.ptrw(), buf, size);
+	js_free(ctx, buf);
+	if (bytecode_cache_enabled) {
+		QuickJSBytecodeCache::save(p_filename, BINDING_SCRIPT_CONTENT, binding_script_bytecode.ptr(), size);
+	}
+	return OK;
+}
+
+// The binding script is parsed once per process, later binders and workers only evaluate its bytecode
+Error QuickJSBinder::eval_binding_script(String &r_error, ECMAScriptGCHandler &r_ret) {
+	static const char *filename = "<internal: binding_script.js>";
+	Vector<uint8_t> bytecode;
+	bool compiled = false;
+	{
+		MutexLock lock(binding_script_mutex);
+		if (binding_script_bytecode.empty() && (!bytecode_cache_enabled || QuickJSBytecodeCache::load(filename, BINDING_SCRIPT_CONTENT, binding_script_bytecode) != OK)) {
+			binding_script_bytecode.clear();
+			Error err = compile_binding_script(filename, r_error);
+			if (err != OK) {
+				return err;
+			}
+			compiled = true;
+		}
+		bytecode = binding_script_bytecode;
+	}
+
+	JSValue ret = JS_ReadObject(ctx, bytecode.ptr(), bytecode.size(), JS_READ_OBJ_BYTECODE);
+	if (JS_IsException(ret) && !compiled) {
+		// The bytecode came from a stale or corrupt cache entry, drop it and compile the source instead
+		JS_FreeValue(ctx, JS_GetException(ctx));
+		{
+			MutexLock lock(binding_script_mutex);
+			binding_script_bytecode.clear();
+			if (bytecode_cache_enabled) {
+				QuickJSBytecodeCache::remove(filename, BINDING_SCRIPT_CONTENT);
+			}
+			Error err = compile_binding_script(filename, r_error);
+			if (err != OK) {
+				return err;
+			}
+			bytecode = binding_script_bytecode;
+		}
+		ret = JS_ReadObject(ctx, bytecode.ptr(), bytecode.size(), JS_READ_OBJ_BYTECODE);
+	}
+	if (!JS_IsException(ret)) {
+		ret = JS_EvalFunction(ctx, ret);
+	}
+	r_ret.context = ctx;
+	r_ret.ecma_object = JS_VALUE_GET_PTR(ret);
+	if (JS_IsException(ret)) {
+		JSValue e = JS_GetException(ctx);
+		ECMAscriptScriptError err;
+		dump_exception(ctx, e, &err);
+		r_error = error_to_string(err);
+		JS_Throw(ctx, e);
+		return ERR_PARSE_ERROR;
+	}
+	return OK;
+}
+
 Error QuickJSBinder::compile_to_bytecode(const String &p_code, const String &p_file, Vector<uint8_t> &r_bytecode) {
 	ECMAscriptScriptError script_err;
 	ModuleCache mc = js_compile_module(ctx, p_code, p_file, &script_err);
@@ -1548,23 +2359,49 @@ Error QuickJSBinder::compile_to_bytecode(const String &p_code, const String &p_f
 }
 
 Error QuickJSBinder::load_bytecode(const Vector<uint8_t> &p_bytecode, const String &p_file, ECMAScriptGCHandler *r_module) {
+	uint32_t size = 0;
+	uint32_t hash = 0;
+	if (const uint8_t *bundled = ResourceFormatLoaderECMAScriptModule::get_bundled_bytecode_ptr(p_file, &size, &hash)) {
+		return load_bytecode(bundled, size, hash, p_file, r_module);
+	}
+
+	const uint8_t *ptr = p_bytecode.ptr();
+	size = p_bytecode.size();
+	if (size >= ECMASCRIPT_BYTECODE_HEADER_SIZE && decode_uint32(ptr) == ECMASCRIPT_BYTECODE_MAGIC) {
+		hash = decode_uint32(ptr + 4);
+		ptr += ECMASCRIPT_BYTECODE_HEADER_SIZE;
+		size -= ECMASCRIPT_BYTECODE_HEADER_SIZE;
+	} else {
+		hash = hash_djb2_buffer(ptr, size);
+	}
 
-	Variant bytes = p_bytecode;
+	if (ModuleCache *cached = module_cache.getptr(p_file)) {
+		if (cached->hash == hash) {
+			r_module->ecma_object = cached->module;
+			return OK;
+		}
+	}
+	return load_bytecode(ptr, size, hash, p_file, r_module);
+}
+
+Error QuickJSBinder::load_bytecode(const uint8_t *p_bytecode, size_t p_size, uint32_t p_hash, const String &p_file, ECMAScriptGCHandler *r_module) {
 	if (ModuleCache *ptr = module_cache.getptr(p_file)) {
-		if (bytes.hash() == ptr->hash) {
+		if (p_hash == ptr->hash) {
 			r_module->ecma_object = ptr->module;
 			return OK;
 		}
 	}
 
-	JSValue value = JS_ReadObject(ctx, p_bytecode.ptr(), p_bytecode.size(), JS_READ_OBJ_BYTECODE | JS_READ_OBJ_REFERENCE | JS_READ_OBJ_SAB | JS_READ_OBJ_ROM_DATA);
+	// The functions get their own copy of the bytecode. Reading it in place with JS_READ_OBJ_ROM_DATA only
+	// works when the atoms of the buffer already have their ids in this runtime, which is never the case here
+	JSValue value = JS_ReadObject(ctx, p_bytecode, p_size, JS_READ_OBJ_BYTECODE | JS_READ_OBJ_REFERENCE | JS_READ_OBJ_SAB);
 	ERR_FAIL_COND_V(JS_VALUE_GET_TAG(value) != JS_TAG_MODULE, ERR_PARSE_ERROR);
 	void *ptr = JS_VALUE_GET_PTR(value);
 	r_module->ecma_object = ptr;
 
 	ModuleCache mc;
 	mc.flags = MODULE_FLAG_SCRIPT;
-	mc.hash = bytes.hash();
+	mc.hash = p_hash;
 	mc.module = static_cast<JSModuleDef *>(ptr);
 	module_cache.set(p_file, mc);
 
@@ -1578,6 +2415,78 @@ Error QuickJSBinder::load_bytecode(const Vector<uint8_t> &p_bytecode, const Stri
 	return OK;
 }
 
+static int standalone_stub_module_init(JSContext *ctx, JSModuleDef *m) {
+	return 0;
+}
+
+static JSModuleDef *standalone_module_loader(JSContext *ctx, const char *module_name, void *opaque) {
+	return JS_NewCModule(ctx, module_name, standalone_stub_module_init);
+}
+
+JSContext *QuickJSBinder::new_standalone_context() {
+	JSRuntime *rt = JS_NewRuntime();
+	ERR_FAIL_NULL_V(rt, NULL);
+	JS_SetModuleLoaderFunc(rt, NULL, standalone_module_loader, NULL);
+	JSContext *ctx = JS_NewContext(rt);
+	JS_AddIntrinsicOperators(ctx);
+	return ctx;
+}
+
+void QuickJSBinder::free_standalone_context(JSContext *ctx) {
+	JSRuntime *rt = JS_GetRuntime(ctx);
+	JS_FreeContext(ctx);
+	JS_FreeRuntime(rt);
+}
+
+Error QuickJSBinder::compile_module_standalone(JSContext *ctx, const String &p_code, const String &p_file, Vector<uint8_t> &r_bytecode, ECMAscriptScriptError *r_error, List<String> *r_imports) {
+	CharString code = p_code.utf8();
+	CharString filename = p_file.utf8();
+	JSValue module = JS_Eval(ctx, code.get_data(), code.length(), filename.get_data(), JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
+	if (JS_IsException(module)) {
+		JSValue e = JS_GetException(ctx);
+		dump_exception(ctx, e, r_error);
+		JS_FreeValue(ctx, e);
+		return ERR_PARSE_ERROR;
+	}
+	if (r_imports) {
+		get_module_imports(ctx, static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(module)), r_imports);
+	}
+	size_t size;
+	uint8_t *buf = JS_WriteObject(ctx, &size, module, JS_WRITE_OBJ_BYTECODE | JS_WRITE_OBJ_REFERENCE | JS_WRITE_OBJ_SAB);
+	JS_FreeValue(ctx, module);
+	ERR_FAIL_NULL_V(buf, ERR_PARSE_ERROR);
+	r_bytecode.resize(size);
+	copymem(r_bytecode.ptrw(), buf, size);
+	js_free(ctx, buf);
+	return OK;
+}
+
+Error QuickJSBinder::read_module_imports(JSContext *ctx, const Vector<uint8_t> &p_bytecode, List<String> *r_imports) {
+	JSValue module = JS_ReadObject(ctx, p_bytecode.ptr(), p_bytecode.size(), JS_READ_OBJ_BYTECODE | JS_READ_OBJ_REFERENCE | JS_READ_OBJ_SAB);
+	if (JS_VALUE_GET_TAG(module) != JS_TAG_MODULE) {
+		JS_FreeValue(ctx, module);
+		JS_FreeValue(ctx, JS_GetException(ctx));
+		return ERR_PARSE_ERROR;
+	}
+	get_module_imports(ctx, static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(module)), r_imports);
+	JS_FreeValue(ctx, module);
+	return OK;
+}
+
+// Import specifiers are returned as written in the source, relative ones are not normalized
+void QuickJSBinder::get_module_imports(JSContext *ctx, JSModuleDef *p_module, List<String> *r_imports) {
+	const int count = JS_GetModuleRequestCount(p_module);
+	for (int i = 0; i < count; i++) {
+		JSAtom name = JS_GetModuleRequestName(ctx, p_module, i);
+		const char *str = JS_AtomToCString(ctx, name);
+		String specifier;
+		specifier.parse_utf8(str);
+		JS_FreeCString(ctx, str);
+		JS_FreeAtom(ctx, name);
+		r_imports->push_back(specifier);
+	}
+}
+
 /************************* Memory Management ******************************/
 
 void *QuickJSBinder::alloc_object_binding_data(Object *p_object) {
@@ -1598,17 +2507,17 @@ void QuickJSBinder::free_object_binding_data(void *p_gc_handle) {
 
 Error QuickJSBinder::bind_gc_object(JSContext *ctx, ECMAScriptGCHandler *data, Object *p_object) {
 	QuickJSBinder *binder = get_context_binder(ctx);
-	const ClassBindData **bind_ptr = binder->classname_bindings.getptr(p_object->get_class_name());
-	if (!bind_ptr)
-		bind_ptr = binder->classname_bindings.getptr(p_object->get_parent_class_static());
-	if (!bind_ptr) {
-		bind_ptr = Object::cast_to<Reference>(p_object) == NULL ? &binder->godot_object_class : &binder->godot_reference_class;
+	const ClassBindData *bind = binder->get_class_binding(p_object->get_class_name());
+	if (!bind)
+		bind = binder->get_class_binding(p_object->get_parent_class_static());
+	if (!bind) {
+		bind = Object::cast_to<Reference>(p_object) == NULL ? binder->godot_object_class : binder->godot_reference_class;
 #ifdef DEBUG_ENABLED
 		WARN_PRINTS("Class " + p_object->get_class_name() + " is not registed to ClassDB");
 #endif
 	}
-	if (bind_ptr) {
-		JSValue obj = JS_NewObjectProtoClass(ctx, (*bind_ptr)->prototype, binder->get_origin_class_id());
+	if (bind) {
+		JSValue obj = JS_NewObjectProtoClass(ctx, bind->prototype, binder->get_origin_class_id());
 		data->ecma_object = JS_VALUE_GET_PTR(obj);
 		data->context = ctx;
 		data->godot_object = p_object;
@@ -1709,7 +2618,7 @@ void QuickJSBinder::initialize_properties(JSContext *ctx, const ECMAClassInfo *p
 	const StringName *prop_name = p_class->properties.next(NULL);
 	QuickJSBinder *binder = get_context_binder(ctx);
 	while (prop_name) {
-		JSAtom pname = get_atom(ctx, *prop_name);
+		JSAtom pname = binder->get_cached_atom(*prop_name);
 		int ret = JS_SetProperty(ctx, p_object, pname, variant_to_var(ctx, p_class->properties.getptr(*prop_name)->default_value));
 		if (ret < 0) {
 			JSValue e = JS_GetException(ctx);
@@ -1718,7 +2627,6 @@ void QuickJSBinder::initialize_properties(JSContext *ctx, const ECMAClassInfo *p
 			JS_FreeValue(ctx, e);
 			ERR_PRINTS(vformat("Cannot initialize property '%s' of class '%s'\n%s", *prop_name, p_class->class_name, binder->error_to_string(error)));
 		}
-		JS_FreeAtom(ctx, pname);
 		prop_name = p_class->properties.next(prop_name);
 	}
 }
@@ -1906,20 +2814,34 @@ const ECMAClassInfo *QuickJSBinder::register_ecma_class(const JSValue &p_constru
 		JS_FreeValue(ctx, props);
 
 		// methods
-		Set<String> keys;
-		get_own_property_names(ctx, prototype, &keys);
-		for (Set<String>::Element *E = keys.front(); E; E = E->next()) {
-			StringName method_name = E->get();
-			JSAtom key = get_atom(ctx, method_name);
-			JSValue value = JS_GetProperty(ctx, prototype, key);
-			if (JS_IsFunction(ctx, value)) {
-				MethodInfo mi;
-				mi.name = E->get();
-				ecma_class.methods.set(method_name, mi);
+		// Resolve the script methods along the prototype chain down to the native class once,
+		// so the instance can dispatch calls from engine with a hash lookup
+		JSValue proto = JS_DupValue(ctx, prototype);
+		while (JS_IsObject(proto) && JS_VALUE_GET_PTR(proto) != JS_VALUE_GET_PTR(bind->prototype)) {
+			Set<String> keys;
+			get_own_property_names(ctx, proto, &keys);
+			for (Set<String>::Element *E = keys.front(); E; E = E->next()) {
+				StringName method_name = E->get();
+				if (ecma_class.method_functions.has(method_name)) continue;
+				JSAtom key = get_atom(ctx, method_name);
+				JSValue value = JS_GetProperty(ctx, proto, key);
+				if (JS_IsFunction(ctx, value) && !JS_IsPureCFunction(ctx, value)) {
+					MethodInfo mi;
+					mi.name = E->get();
+					ecma_class.methods.set(method_name, mi);
+					ECMAMethodInfo method;
+					method.context = ctx;
+					method.ecma_object = JS_VALUE_GET_PTR(JS_DupValue(ctx, value));
+					ecma_class.method_functions.set(method_name, method);
+				}
+				JS_FreeValue(ctx, value);
+				JS_FreeAtom(ctx, key);
 			}
-			JS_FreeValue(ctx, value);
-			JS_FreeAtom(ctx, key);
+			JSValue parent = JS_GetPrototype(ctx, proto);
+			JS_FreeValue(ctx, proto);
+			proto = parent;
 		}
+		JS_FreeValue(ctx, proto);
 
 		// cache the class
 		if (const ECMAClassInfo *ptr = binder->ecma_classes.getptr(p_path)) {
@@ -1937,6 +2859,11 @@ fail:
 }
 
 void QuickJSBinder::free_ecmas_class(const ECMAClassInfo &p_class) {
+	const StringName *key = p_class.method_functions.next(NULL);
+	while (key) {
+		JS_FreeValue(ctx, GET_JSVALUE(p_class.method_functions.get(*key)));
+		key = p_class.method_functions.next(key);
+	}
 	JSValue class_func = JS_MKPTR(JS_TAG_OBJECT, p_class.constructor.ecma_object);
 	JS_FreeValue(ctx, class_func);
 }
@@ -2050,6 +2977,52 @@ JSValue QuickJSBinder::global_cancel_animation_frame(JSContext *ctx, JSValue thi
 	return JS_UNDEFINED;
 }
 
+JSValue QuickJSBinder::global_set_timer(JSContext *ctx, JSValue this_val, int argc, JSValue *argv, int magic) {
+	ERR_FAIL_COND_V(argc < 1 || !JS_IsFunction(ctx, argv[0]), JS_ThrowTypeError(ctx, "Function expected for argument #0"));
+	double delay = 0;
+	if (argc > 1 && JS_ToFloat64(ctx, &delay, argv[1])) {
+		return JS_EXCEPTION;
+	}
+	if (!(delay > 0)) delay = 0;
+
+	QuickJSBinder *binder = get_context_binder(ctx);
+	Timer timer;
+	timer.callback = JS_DupValue(ctx, argv[0]);
+	for (int i = 2; i < argc; i++) {
+		timer.arguments.push_back(JS_DupValue(ctx, argv[i]));
+	}
+	timer.interval = uint64_t(MIN(delay, double(INT32_MAX)) * 1000);
+	timer.repeat = magic == 1;
+	const int64_t id = ++binder->last_timer_id;
+	binder->timers.set(id, timer);
+	binder->timer_queue.push(binder->get_timer_deadline(timer.interval), id);
+	return JS_NewInt64(ctx, id);
+}
+
+JSValue QuickJSBinder::global_clear_timer(JSContext *ctx, JSValue this_val, int argc, JSValue *argv) {
+	if (argc < 1 || !JS_IsNumber(argv[0])) return JS_UNDEFINED;
+	const int64_t id = js_to_int64(ctx, argv[0]);
+	QuickJSBinder *binder = get_context_binder(ctx);
+	if (Timer *timer = binder->timers.getptr(id)) {
+		binder->free_timer(*timer);
+		binder->timers.erase(id);
+		binder->timer_queue.cancel(id);
+	}
+	return JS_UNDEFINED;
+}
+
+JSValue QuickJSBinder::global_queue_microtask(JSContext *ctx, JSValue this_val, int argc, JSValue *argv) {
+	ERR_FAIL_COND_V(argc < 1 || !JS_IsFunction(ctx, argv[0]), JS_ThrowTypeError(ctx, "Function expected for argument #0"));
+	if (JS_EnqueueJob(ctx, microtask_job, 1, argv) < 0) {
+		return JS_EXCEPTION;
+	}
+	return JS_UNDEFINED;
+}
+
+JSValue QuickJSBinder::microtask_job(JSContext *ctx, int argc, JSValueConst *argv) {
+	return JS_Call(ctx, argv[0], JS_UNDEFINED, 0, NULL);
+}
+
 int QuickJSBinder::get_js_array_length(JSContext *ctx, JSValue p_val) {
 	if (!JS_IsArray(ctx, p_val)) return -1;
 	JSValue ret = JS_GetProperty(ctx, p_val, JS_ATOM_length);
@@ -2099,23 +3072,31 @@ ECMAScriptGCHandler QuickJSBinder::create_ecma_instance_for_godot_object(const E
 Variant QuickJSBinder::call_method(const ECMAScriptGCHandler &p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
 
 	JSValue object = GET_JSVALUE(p_object);
-	JSAtom atom = get_atom(ctx, p_method);
-	JSValue method = JS_GetProperty(ctx, object, atom);
-	JS_FreeAtom(ctx, atom);
-
-	JSValue return_val = JS_UNDEFINED;
-	JSValue *argv = NULL;
+	JSValue method = JS_GetProperty(ctx, object, get_cached_atom(p_method));
 
+	Variant ret;
 	if (!JS_IsFunction(ctx, method) || JS_IsPureCFunction(ctx, method)) {
 		r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
-		goto finish;
+	} else {
+		ECMAScriptGCHandler func;
+		func.context = ctx;
+		func.ecma_object = JS_VALUE_GET_PTR(method);
+		ret = call(func, p_object, p_args, p_argcount, r_error);
 	}
+	JS_FreeValue(ctx, method);
+	return ret;
+}
+
+Variant QuickJSBinder::call(const ECMAScriptGCHandler &p_fuction, const ECMAScriptGCHandler &p_target, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+
+	JSValue method = GET_JSVALUE(p_fuction);
+	JSValue object = GET_JSVALUE(p_target);
 
-	argv = memnew_arr(JSValue, p_argcount);
+	JSMethodArguments args(p_argcount);
 	for (int i = 0; i < p_argcount; ++i) {
-		argv[i] = variant_to_var(ctx, *p_args[i]);
+		args.argv[i] = variant_to_var(ctx, *p_args[i]);
 	}
-	return_val = JS_Call(ctx, method, object, p_argcount, argv);
+	JSValue return_val = JS_Call(ctx, method, object, p_argcount, args.argv);
 
 	if (JS_IsException(return_val)) {
 		r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
@@ -2127,25 +3108,19 @@ Variant QuickJSBinder::call_method(const ECMAScriptGCHandler &p_object, const St
 	} else {
 		r_error.error = Variant::CallError::CALL_OK;
 	}
-finish:
+
 	Variant ret = var_to_variant(ctx, return_val);
-	if (argv) {
-		for (int i = 0; i < p_argcount; i++) {
-			JS_FreeValue(ctx, argv[i]);
-		}
-		memdelete_arr(argv);
+	for (int i = 0; i < p_argcount; i++) {
+		JS_FreeValue(ctx, args.argv[i]);
 	}
 	JS_FreeValue(ctx, return_val);
-	JS_FreeValue(ctx, method);
 	return ret;
 }
 
 bool QuickJSBinder::get_instance_property(const ECMAScriptGCHandler &p_object, const StringName &p_name, Variant &r_ret) {
 	bool success = false;
 	JSValue obj = GET_JSVALUE(p_object);
-	JSAtom atom = get_atom(ctx, p_name);
-	JSValue ret = JS_GetProperty(ctx, obj, atom);
-	JS_FreeAtom(ctx, atom);
+	JSValue ret = JS_GetProperty(ctx, obj, get_cached_atom(p_name));
 	r_ret = var_to_variant(ctx, ret);
 	success = !JS_IsUndefined(ret);
 	JS_FreeValue(ctx, ret);
@@ -2154,19 +3129,14 @@ bool QuickJSBinder::get_instance_property(const ECMAScriptGCHandler &p_object, c
 
 bool QuickJSBinder::set_instance_property(const ECMAScriptGCHandler &p_object, const StringName &p_name, const Variant &p_value) {
 	JSValue obj = GET_JSVALUE(p_object);
-	JSAtom atom = get_atom(ctx, p_name);
-	bool success = JS_SetProperty(ctx, obj, atom, variant_to_var(ctx, p_value));
-	JS_FreeAtom(ctx, atom);
-	return success;
+	return JS_SetProperty(ctx, obj, get_cached_atom(p_name), variant_to_var(ctx, p_value));
 }
 
 bool QuickJSBinder::has_method(const ECMAScriptGCHandler &p_object, const StringName &p_name) {
 	JSValue obj = GET_JSVALUE(p_object);
 	ERR_FAIL_COND_V(!JS_IsObject(obj), false);
-	JSAtom atom = get_atom(ctx, p_name);
-	JSValue value = JS_GetProperty(ctx, GET_JSVALUE(p_object), atom);
+	JSValue value = JS_GetProperty(ctx, obj, get_cached_atom(p_name));
 	bool success = JS_IsFunction(ctx, value);
-	JS_FreeAtom(ctx, atom);
 	JS_FreeValue(ctx, value);
 	return success;
 }
@@ -2231,10 +3201,8 @@ bool QuickJSBinder::has_signal(const ECMAClassInfo *p_class, const StringName &p
 		JS_FreeValue(ctx, object);
 		return false;
 	}
-	JSAtom atom = get_atom(ctx, p_signal);
-	JSValue signal = JS_GetProperty(ctx, object, atom);
+	JSValue signal = JS_GetProperty(ctx, object, get_cached_atom(p_signal));
 	found = !JS_IsUndefined(signal);
-	JS_FreeAtom(ctx, atom);
 	JS_FreeValue(ctx, signal);
 	JS_FreeValue(ctx, object);
 	return found;
@@ -2246,7 +3214,32 @@ JSValue QuickJSBinder::worker_constructor(JSContext *ctx, JSValue this_val, int
 	ERR_FAIL_COND_V(argc < 1 || !JS_IsString(argv[0]), JS_ThrowTypeError(ctx, "script path expected for argument #0"));
 	QuickJSBinder *host = QuickJSBinder::get_context_binder(ctx);
 
+	int queue_capacity = GLOBAL_DEF("JavaScript/worker/message_queue_capacity", 1024);
+	bool block_on_full_queue = GLOBAL_DEF("JavaScript/worker/block_on_full_queue", true);
+	// new Worker(path, { highWaterMark: 256, overflow: 'drop' })
+	if (argc > 1 && JS_IsObject(argv[1])) {
+		JSValue high_water_mark = JS_GetPropertyStr(ctx, argv[1], "highWaterMark");
+		if (JS_IsNumber(high_water_mark)) {
+			int32_t value;
+			JS_ToInt32(ctx, &value, high_water_mark);
+			queue_capacity = MAX(value, 1);
+		}
+		JS_FreeValue(ctx, high_water_mark);
+		JSValue overflow = JS_GetPropertyStr(ctx, argv[1], "overflow");
+		if (JS_IsString(overflow)) {
+			const String policy = js_to_string(ctx, overflow);
+			if (policy == "drop" || policy == "block") {
+				block_on_full_queue = policy == "block";
+			} else {
+				JS_FreeValue(ctx, overflow);
+				return JS_ThrowTypeError(ctx, "overflow must be 'block' or 'drop'");
+			}
+		}
+		JS_FreeValue(ctx, overflow);
+	}
+
 	QuickJSWorker *worker = memnew(QuickJSWorker(host));
+	worker->setup_message_queues(queue_capacity, block_on_full_queue);
 	worker->start(js_to_string(ctx, argv[0]));
 	JSValue obj = JS_NewObjectProtoClass(ctx, host->worker_class_data.prototype, host->worker_class_data.class_id);
 
@@ -2277,7 +3270,20 @@ JSValue QuickJSBinder::worker_post_message(JSContext *ctx, JSValue this_val, int
 	QuickJSBinder *host = QuickJSBinder::get_context_binder(ctx);
 	if (ECMAScriptGCHandler *bind = static_cast<ECMAScriptGCHandler *>(JS_GetOpaque(this_val, host->worker_class_data.class_id))) {
 		QuickJSWorker *worker = static_cast<QuickJSWorker *>(bind->native_ptr);
-		worker->post_message_from_host(var_to_variant(ctx, argv[0]));
+		Variant message;
+		if (!js_to_message(ctx, argv[0], argc > 1 ? argv[1] : JS_UNDEFINED, message)) {
+			return JS_EXCEPTION;
+		}
+		return JS_NewBool(ctx, worker->post_message_from_host(message));
+	}
+	return JS_FALSE;
+}
+
+JSValue QuickJSBinder::worker_get_stats(JSContext *ctx, JSValue this_val, int argc, JSValue *argv) {
+	QuickJSBinder *host = QuickJSBinder::get_context_binder(ctx);
+	if (ECMAScriptGCHandler *bind = static_cast<ECMAScriptGCHandler *>(JS_GetOpaque(this_val, host->worker_class_data.class_id))) {
+		QuickJSWorker *worker = static_cast<QuickJSWorker *>(bind->native_ptr);
+		return variant_to_var(ctx, worker->get_message_stats());
 	}
 	return JS_UNDEFINED;
 }
@@ -2294,6 +3300,30 @@ JSValue QuickJSBinder::worker_terminate(JSContext *ctx, JSValue this_val, int ar
 	return JS_UNDEFINED;
 }
 
+JSValue QuickJSBinder::godot_set_job_budget(JSContext *ctx, JSValue this_val, int argc, JSValue *argv) {
+	ERR_FAIL_COND_V(argc < 1 || !JS_IsNumber(argv[0]), JS_ThrowTypeError(ctx, "number expected for argument #0"));
+	ERR_FAIL_COND_V(argc > 1 && !JS_IsNumber(argv[1]), JS_ThrowTypeError(ctx, "number expected for argument #1"));
+	QuickJSBinder *binder = get_context_binder(ctx);
+	binder->job_frame_budget_usec = MAX(js_to_int64(ctx, argv[0]), 0);
+	if (argc > 1) {
+		binder->job_frame_max_count = MAX(js_to_int(ctx, argv[1]), 0);
+	}
+	return JS_UNDEFINED;
+}
+
+JSValue QuickJSBinder::godot_get_job_stats(JSContext *ctx, JSValue this_val, int argc, JSValue *argv) {
+	QuickJSBinder *binder = get_context_binder(ctx);
+	Dictionary stats;
+	stats["budget_usec"] = binder->job_frame_budget_usec;
+	stats["max_jobs"] = binder->job_frame_max_count;
+	stats["jobs_run"] = binder->jobs_run;
+	stats["jobs_deferred"] = binder->jobs_deferred;
+	stats["frames_deferred"] = binder->job_frames_deferred;
+	stats["time_usec"] = binder->job_time_usec;
+	stats["max_frame_time_usec"] = binder->job_max_frame_time_usec;
+	return variant_to_var(ctx, stats);
+}
+
 JSValue QuickJSBinder::godot_abandon_value(JSContext *ctx, JSValue this_val, int argc, JSValue *argv) {
 	ERR_FAIL_COND_V(argc != 1, JS_ThrowTypeError(ctx, "one argument expected"));
 	JSValue &value = argv[0];
@@ -2364,6 +3394,9 @@ void QuickJSBinder::add_global_worker() {
 	// Worker.prototype.postMessage
 	JSValue post_message_func = JS_NewCFunction(ctx, worker_post_message, "postMessage", 1);
 	JS_DefinePropertyValueStr(ctx, worker_class_data.prototype, "postMessage", post_message_func, PROP_DEF_DEFAULT);
+	// Worker.prototype.getStats
+	JSValue get_stats_func = JS_NewCFunction(ctx, worker_get_stats, "getStats", 0);
+	JS_DefinePropertyValueStr(ctx, worker_class_data.prototype, "getStats", get_stats_func, PROP_DEF_DEFAULT);
 	// Worker.prototype.terminate
 	JSValue terminate_func = JS_NewCFunction(ctx, worker_terminate, "terminate", 1);
 	JS_DefinePropertyValueStr(ctx, worker_class_data.prototype, "terminate", terminate_func, PROP_DEF_DEFAULT);
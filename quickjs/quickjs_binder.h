@@ -9,15 +9,22 @@
 #endif
 
 #include "core/os/memory.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/resource.h"
 #include "quickjs_builtin_binder.h"
+#include "quickjs_class_table.h"
+#include "quickjs_module_prefetcher.h"
+#include "quickjs_timer_queue.h"
+#include "quickjs_transferred_buffer.h"
 #define JS_HIDDEN_SYMBOL(x) ("\xFF" x)
 #define BINDING_DATA_FROM_JS(ctx, p_val) (ECMAScriptGCHandler *)JS_GetOpaque((p_val), QuickJSBinder::get_origin_class_id((ctx)))
 #define GET_JSVALUE(p_gc_handler) JS_MKPTR(JS_TAG_OBJECT, (p_gc_handler).ecma_object)
 #define NO_MODULE_EXPORT_SUPPORT 0
 #define MODULE_HAS_REFCOUNT 0 // module seems don't follow the refrence count rule in quickjs
 #define MAX_ARGUMENT_COUNT 50
+#define STACK_ARGUMENT_COUNT 8
+#define MAX_ATOM_CACHE_SIZE 4096
 #define PROP_NAME_CONSOLE_LOG_OBJECT_TO_JSON "LOG_OBJECT_TO_JSON"
 #define ENDL "\r\n"
 
@@ -41,6 +48,10 @@ protected:
 	Ref<QuickJSDebugger> debugger;
 #endif
 
+	// Makes this binder the one get_thread_binder returns on the calling thread
+	virtual void bind_thread();
+	virtual void unbind_thread();
+
 public:
 	struct PtrHasher {
 		static _FORCE_INLINE_ uint32_t hash(const void *p_ptr) {
@@ -108,6 +119,20 @@ protected:
 	JSAtom js_key_godot_exports;
 	JSAtom js_key_godot_signals;
 
+	// StringName -> JSAtom cache used by engine -> script dispatch
+	// The StringName is kept alive so its data pointer stays unique while cached
+	struct AtomCacheEntry {
+		StringName name;
+		JSAtom atom;
+	};
+	HashMap<const void *, AtomCacheEntry, PtrHasher> atom_cache;
+	uint64_t atom_cache_hits;
+	uint64_t atom_cache_misses;
+	// Repeated sub-objects convert to the same Dictionary or Array
+	bool share_converted_references;
+	bool bytecode_cache_enabled;
+	bool module_prefetch_enabled;
+
 	JSValue global_object;
 	JSValue godot_object;
 	JSValue console_object;
@@ -128,6 +153,7 @@ protected:
 	ModuleCache *js_compile_and_cache_module(JSContext *ctx, const String &p_code, const String &p_filename, ECMAscriptScriptError *r_error);
 	ModuleCache *js_compile_and_cache_module(JSContext *ctx, const Vector<uint8_t> &p_bytecode, const String &p_filename, ECMAscriptScriptError *r_error);
 	ModuleCache js_compile_module(JSContext *ctx, const String &p_code, const String &p_filename, ECMAscriptScriptError *r_error);
+	JSValue read_compiled_module(JSContext *ctx, const Vector<uint8_t> &p_bytecode);
 	static Error js_evalute_module(JSContext *ctx, ModuleCache *p_module, ECMAscriptScriptError *r_error);
 	static int resource_module_initializer(JSContext *ctx, JSModuleDef *m);
 
@@ -145,23 +171,59 @@ protected:
 	const ClassBindData *godot_reference_class;
 	HashMap<JSClassID, ClassBindData> class_bindings;
 	HashMap<StringName, const ClassBindData *> classname_bindings;
+	// Shared by every binder, method and class indices into it are the same in all of them
+	const QuickJSClassTable *class_table;
 	HashMap<String, ModuleCache> module_cache;
+	List<String> compiling_modules;
+	// Modules compiled ahead of linking, consumed when their import is resolved
+	HashMap<String, QuickJSModulePrefetcher::Module> prefetched_modules;
+	QuickJSModulePrefetcher::Graph *prefetch_graph;
 	HashMap<String, CommonJSModule> commonjs_module_cache;
 	ClassBindData worker_class_data;
 	List<ECMAScriptGCHandler *> workers;
-	Vector<MethodBind *> godot_methods;
-	int internal_godot_method_id;
-	Vector<const ClassDB::PropertySetGet *> godot_object_indexed_properties;
-	int internal_godot_indexed_property_id;
 	const ECMAScriptGCHandler *lastest_allocated_object = NULL;
 
+	struct Timer {
+		JSValue callback;
+		Vector<JSValue> arguments;
+		uint64_t interval;
+		bool repeat;
+	};
+	// setTimeout and setInterval callbacks, each frame only visits the expired ones
+	HashMap<int64_t, Timer> timers;
+	QuickJSTimerQueue timer_queue;
+	int64_t last_timer_id = 0;
+	// Set while timers fire, timers created by their callbacks are not due before the next frame
+	uint64_t timer_fire_time = 0;
+	// Time the timer callbacks may take each frame, 0 for no limit
+	uint64_t timer_frame_budget_usec = 0;
+	uint64_t get_timer_deadline(uint64_t p_delay_usec) const;
+
+	// Limits of the promise jobs run each frame, 0 for no limit
+	uint64_t job_frame_budget_usec = 0;
+	int job_frame_max_count = 0;
+	uint64_t jobs_run = 0;
+	// Jobs carried over to the next frame because the budget ran out, each job is counted once
+	uint64_t jobs_deferred = 0;
+	// Jobs left queued by the last frame, they run first in the next one
+	int job_carried_over = 0;
+	uint64_t job_frames_deferred = 0;
+	uint64_t job_time_usec = 0;
+	uint64_t job_max_frame_time_usec = 0;
+	void run_pending_jobs();
+	void fire_timers();
+	void free_timer(Timer &p_timer);
+
 #if NO_MODULE_EXPORT_SUPPORT
 	String parsing_script_file;
 #endif
 
-	JSClassID register_class(const ClassDB::ClassInfo *p_cls);
+	JSClassID register_class(const QuickJSClassTable::Class &p_cls);
 	void add_godot_origin();
 	void add_godot_classes();
+	const ClassBindData *get_class_binding(const StringName &p_class);
+	const ClassBindData *get_class_binding(int p_index);
+	static JSValue godot_class_getter(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv, int magic);
 	void add_godot_globals();
 	void add_global_console();
 	void add_global_properties();
@@ -198,24 +260,51 @@ protected:
 	static JSValue console_functions(JSContext *ctx, JSValue this_val, int argc, JSValue *argv, int magic);
 	static JSValue global_request_animation_frame(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 	static JSValue global_cancel_animation_frame(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+	static JSValue global_set_timer(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv, int magic);
+	static JSValue global_clear_timer(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+	static JSValue global_queue_microtask(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+	static JSValue microtask_job(JSContext *ctx, int argc, JSValueConst *argv);
 
 	static JSValue worker_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 	static void worker_finializer(JSRuntime *rt, JSValue val);
 	static JSValue worker_post_message(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+	static JSValue worker_get_stats(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 	static JSValue worker_terminate(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 	static JSValue godot_abandon_value(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 	static JSValue godot_adopt_value(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+	static JSValue godot_set_job_budget(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+	static JSValue godot_get_job_stats(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 
 	_FORCE_INLINE_ static JSValue js_empty_func(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) { return JS_UNDEFINED; }
 	_FORCE_INLINE_ static JSValue js_empty_consturctor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) { return JS_NewObject(ctx); }
 	static JSValue godot_builtin_function(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv, int magic);
 
 	static int get_js_array_length(JSContext *ctx, JSValue p_val);
+	// State shared by the nested conversions of one variant_to_var call
+	struct ContainerConversionState {
+		HashMap<String, JSAtom> key_atoms;
+		// ArrayBuffers created for the transferred buffers of a message
+		HashMap<const void *, JSValue, PtrHasher> buffers;
+	};
+	static JSValue container_to_var(JSContext *ctx, const Variant &p_var, ContainerConversionState &r_state);
+	_FORCE_INLINE_ static bool is_transferred_buffer(Object *p_object) {
+		return Object::cast_to<QuickJSTransferredBuffer>(p_object) || Object::cast_to<QuickJSTransferredView>(p_object);
+	}
+	static JSValue transferred_to_var(JSContext *ctx, Object *p_object, ContainerConversionState &r_state);
+	static void free_conversion_state(JSContext *ctx, ContainerConversionState &r_state);
 	static void get_own_property_names(JSContext *ctx, JSValue p_object, Set<String> *r_list);
 
 	static JSAtom get_atom(JSContext *ctx, const StringName &p_key);
+	JSAtom get_cached_atom(const StringName &p_key);
+	void clear_atom_cache();
 	static HashMap<uint64_t, Variant> transfer_deopot;
 	static Map<String, const char *> class_remap;
+	// Compiled binding script shared by every binder in the process
+	static Mutex *binding_script_mutex;
+	static Vector<uint8_t> binding_script_bytecode;
+	// Compiles the binding script into binding_script_bytecode, binding_script_mutex must be held
+	Error compile_binding_script(const char *p_filename, String &r_error);
+	Error eval_binding_script(String &r_error, ECMAScriptGCHandler &r_ret);
 #ifdef TOOLS_ENABLED
 	Dictionary modified_api;
 #endif
@@ -225,13 +314,44 @@ public:
 public:
 	static JSValue variant_to_var(JSContext *ctx, const Variant p_var);
 	static Variant var_to_variant(JSContext *ctx, JSValue p_val);
+	// State shared by the nested conversions of one var_to_variant call
+	struct VariantConversionState {
+		HashMap<const void *, bool, PtrHasher> visiting;
+		HashMap<const void *, Variant, PtrHasher> converted;
+		// Objects used as keys, kept alive so their addresses are not reused during the conversion
+		Vector<JSValue> retained;
+		// ArrayBuffers and pool arrays in the transfer list of postMessage
+		HashMap<const void *, bool, PtrHasher> transfer;
+		HashMap<const void *, Ref<QuickJSTransferredBuffer>, PtrHasher> buffers;
+		bool share_references;
+		// ArrayBuffers and TypedArrays are only carried by Worker messages
+		bool clone_buffers;
+
+		VariantConversionState() {
+			share_references = false;
+			clone_buffers = false;
+		}
+	};
+	static Variant var_to_variant(JSContext *ctx, JSValue p_val, VariantConversionState &r_state);
+	static void free_conversion_state(JSContext *ctx, VariantConversionState &r_state);
+	static Variant js_to_transferred_buffer(JSContext *ctx, JSValueConst p_val, VariantConversionState &r_state);
+	// Converts a Worker message, the ArrayBuffers and pool arrays of the transfer list are moved and detached from the sender
+	static bool js_to_message(JSContext *ctx, JSValueConst p_message, JSValueConst p_transfer, Variant &r_message);
+	// Converts a JS array holding only numbers without going through an intermediate Array
+	static bool js_array_to_pool_array(JSContext *ctx, JSValueConst p_val, PoolByteArray &r_array);
+	static bool js_array_to_pool_array(JSContext *ctx, JSValueConst p_val, PoolIntArray &r_array);
+	static bool js_array_to_pool_array(JSContext *ctx, JSValueConst p_val, PoolRealArray &r_array);
+	template <class T>
+	static bool js_array_to_pool_array(JSContext *ctx, JSValueConst p_val, PoolVector<T> &r_array) { return false; }
+	static bool js_array_to_pool_variant(JSContext *ctx, JSValueConst p_val, Variant::Type p_type, Variant &r_variant);
 	static bool validate_type(JSContext *ctx, Variant::Type p_type, JSValueConst &p_val);
 	static void dump_exception(JSContext *ctx, const JSValueConst &p_exception, ECMAscriptScriptError *r_error);
 	virtual String error_to_string(const ECMAscriptScriptError &p_error);
 	virtual Error get_stacks(List<ECMAScriptStackInfo> &r_stacks);
 	virtual String get_backtrace_message(const List<ECMAScriptStackInfo> &stacks);
 
-	static Dictionary js_to_dictionary(JSContext *ctx, const JSValueConst &p_val, List<void *> &stack);
+	static Dictionary js_to_dictionary(JSContext *ctx, const JSValueConst &p_val, VariantConversionState &r_state);
+	static Array js_to_array(JSContext *ctx, const JSValueConst &p_val, int p_length, VariantConversionState &r_state);
 
 	_FORCE_INLINE_ static real_t js_to_number(JSContext *ctx, const JSValueConst &p_val) {
 		double_t v = 0;
@@ -293,6 +413,9 @@ public:
 	}
 
 	virtual Thread::ID get_thread_id() const { return thread_id; }
+	_FORCE_INLINE_ bool is_bytecode_cache_enabled() const { return bytecode_cache_enabled; }
+	_FORCE_INLINE_ bool has_cached_module(const String &p_file) const { return module_cache.has(p_file); }
+	_FORCE_INLINE_ void get_cached_modules(List<String> *r_files) const { module_cache.get_key_list(r_files); }
 
 	_FORCE_INLINE_ static QuickJSBinder *get_runtime_binder(JSRuntime *rt) {
 		return static_cast<QuickJSBinder *>(JS_GetMollocState(rt)->opaque);
@@ -306,6 +429,15 @@ public:
 
 	_FORCE_INLINE_ QuickJSBuiltinBinder &get_builtin_binder() { return builtin_binder; }
 
+	// Deadline of the earliest timer, 0 without timers
+	_FORCE_INLINE_ uint64_t get_next_timer_time() const { return timer_queue.empty() ? 0 : timer_queue.top().time; }
+	_FORCE_INLINE_ uint64_t get_atom_cache_hits() const { return atom_cache_hits; }
+	_FORCE_INLINE_ uint64_t get_atom_cache_misses() const { return atom_cache_misses; }
+	_FORCE_INLINE_ real_t get_atom_cache_hit_rate() const {
+		uint64_t total = atom_cache_hits + atom_cache_misses;
+		return total ? real_t(double(atom_cache_hits) / double(total)) : 0;
+	}
+
 	_FORCE_INLINE_ JSClassID get_origin_class_id() { return godot_origin_class.class_id; }
 	_FORCE_INLINE_ const ClassBindData get_origin_class() const { return godot_origin_class; }
 	_FORCE_INLINE_ static JSClassID get_origin_class_id(JSContext *ctx) { return get_context_binder(ctx)->godot_origin_class.class_id; }
@@ -313,7 +445,12 @@ public:
 	virtual void initialize();
 	virtual void uninitialize();
 	virtual void language_finalize();
+	// Creates and frees the locks shared by every binder of the process
+	static void initialize_globals();
+	static void finalize_globals();
 	virtual void frame();
+	// Requests a frame() soon, binders driven by the engine main loop need nothing
+	virtual void wake_up() {}
 
 	virtual void *alloc_object_binding_data(Object *p_object);
 	virtual void free_object_binding_data(void *p_gc_handle);
@@ -327,6 +464,15 @@ public:
 
 	virtual Error compile_to_bytecode(const String &p_code, const String &p_file, Vector<uint8_t> &r_bytecode);
 	virtual Error load_bytecode(const Vector<uint8_t> &p_bytecode, const String &p_file, ECMAScriptGCHandler *r_module);
+	// QuickJS copies what it needs from p_bytecode, the buffer can be released once this returns
+	Error load_bytecode(const uint8_t *p_bytecode, size_t p_size, uint32_t p_hash, const String &p_file, ECMAScriptGCHandler *r_module);
+
+	// Standalone contexts compile modules on any thread, imports are left unresolved
+	static JSContext *new_standalone_context();
+	static void free_standalone_context(JSContext *ctx);
+	static Error compile_module_standalone(JSContext *ctx, const String &p_code, const String &p_file, Vector<uint8_t> &r_bytecode, ECMAscriptScriptError *r_error, List<String> *r_imports = NULL);
+	static Error read_module_imports(JSContext *ctx, const Vector<uint8_t> &p_bytecode, List<String> *r_imports);
+	static void get_module_imports(JSContext *ctx, JSModuleDef *p_module, List<String> *r_imports);
 
 	virtual const ECMAClassInfo *parse_ecma_class(const String &p_code, const String &p_path, bool ignore_cacehe, ECMAscriptScriptError *r_error);
 	virtual const ECMAClassInfo *parse_ecma_class(const Vector<uint8_t> &p_bytecode, const String &p_path, bool ignore_cacehe, ECMAscriptScriptError *r_error);
@@ -334,6 +480,7 @@ public:
 
 	virtual ECMAScriptGCHandler create_ecma_instance_for_godot_object(const ECMAClassInfo *p_class, Object *p_object);
 	virtual Variant call_method(const ECMAScriptGCHandler &p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	virtual Variant call(const ECMAScriptGCHandler &p_fuction, const ECMAScriptGCHandler &p_target, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 	virtual bool get_instance_property(const ECMAScriptGCHandler &p_object, const StringName &p_name, Variant &r_ret);
 	virtual bool set_instance_property(const ECMAScriptGCHandler &p_object, const StringName &p_name, const Variant &p_value);
 	virtual bool has_method(const ECMAScriptGCHandler &p_object, const StringName &p_name);
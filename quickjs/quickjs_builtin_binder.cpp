@@ -4,108 +4,187 @@
 #include "quickjs_binder.h"
 #include <core/io/compression.h>
 #include <core/os/memory.h>
+#include <core/print_string.h>
+
+QuickJSBuiltinBinder::BuiltinPool::BuiltinPool() {
+	block_size = 0;
+	free_list = NULL;
+	live_count = 0;
+	peak_count = 0;
+}
+
+void *QuickJSBuiltinBinder::BuiltinPool::alloc() {
+	if (!free_list) {
+		uint8_t *slab = static_cast<uint8_t *>(memalloc(block_size * SLAB_BLOCK_COUNT));
+		ERR_FAIL_NULL_V(slab, NULL);
+		slabs.push_back(slab);
+		for (int i = SLAB_BLOCK_COUNT - 1; i >= 0; i--) {
+			void *block = slab + i * block_size;
+			*static_cast<void **>(block) = free_list;
+			free_list = block;
+		}
+	}
+	void *block = free_list;
+	free_list = *static_cast<void **>(block);
+	if (++live_count > peak_count) {
+		peak_count = live_count;
+	}
+	return block;
+}
+
+void QuickJSBuiltinBinder::BuiltinPool::free(void *p_block) {
+	*static_cast<void **>(p_block) = free_list;
+	free_list = p_block;
+	--live_count;
+}
+
+void QuickJSBuiltinBinder::BuiltinPool::clear() {
+	for (List<void *>::Element *E = slabs.front(); E; E = E->next()) {
+		memfree(E->get());
+	}
+	slabs.clear();
+	free_list = NULL;
+	live_count = 0;
+}
 
 QuickJSBuiltinBinder::QuickJSBuiltinBinder() {
 	ctx = NULL;
 	builtin_class_map = memnew_arr(BuiltinClass, Variant::VARIANT_MAX);
+	builtin_pools = memnew_arr(BuiltinPool, Variant::VARIANT_MAX);
+
+#define SET_POOL_BLOCK_SIZE(m_type, m_class) \
+	builtin_pools[Variant::m_type].block_size = (sizeof(ECMAScriptGCHandler) + sizeof(m_class) + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+	SET_POOL_BLOCK_SIZE(VECTOR2, Vector2)
+	SET_POOL_BLOCK_SIZE(RECT2, Rect2)
+	SET_POOL_BLOCK_SIZE(COLOR, Color)
+	SET_POOL_BLOCK_SIZE(VECTOR3, Vector3)
+	SET_POOL_BLOCK_SIZE(BASIS, Basis)
+	SET_POOL_BLOCK_SIZE(QUAT, Quat)
+	SET_POOL_BLOCK_SIZE(PLANE, Plane)
+	SET_POOL_BLOCK_SIZE(TRANSFORM2D, Transform2D)
+	SET_POOL_BLOCK_SIZE(_RID, RID)
+	SET_POOL_BLOCK_SIZE(TRANSFORM, Transform)
+	SET_POOL_BLOCK_SIZE(AABB, AABB)
+	SET_POOL_BLOCK_SIZE(POOL_INT_ARRAY, PoolIntArray)
+	SET_POOL_BLOCK_SIZE(POOL_BYTE_ARRAY, PoolByteArray)
+	SET_POOL_BLOCK_SIZE(POOL_REAL_ARRAY, PoolRealArray)
+	SET_POOL_BLOCK_SIZE(POOL_COLOR_ARRAY, PoolColorArray)
+	SET_POOL_BLOCK_SIZE(POOL_STRING_ARRAY, PoolStringArray)
+	SET_POOL_BLOCK_SIZE(POOL_VECTOR2_ARRAY, PoolVector2Array)
+	SET_POOL_BLOCK_SIZE(POOL_VECTOR3_ARRAY, PoolVector3Array)
+#undef SET_POOL_BLOCK_SIZE
 }
 
 QuickJSBuiltinBinder::~QuickJSBuiltinBinder() {
+	release_pools();
+	memdelete_arr(builtin_pools);
 	memdelete_arr(builtin_class_map);
 }
 
+void QuickJSBuiltinBinder::release_pools() {
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		BuiltinPool &pool = builtin_pools[i];
+		if (pool.slabs.size()) {
+			print_verbose(vformat("ECMAScript %s binding pool: %d blocks at peak, %d still alive", Variant::get_type_name(Variant::Type(i)), pool.peak_count, pool.live_count));
+		}
+		pool.clear();
+	}
+}
+
 void QuickJSBuiltinBinder::bind_builtin_object(JSContext *ctx, JSValue target, Variant::Type p_type, const void *p_object) {
 
+	QuickJSBuiltinBinder &builtin_binder = QuickJSBinder::get_context_binder(ctx)->builtin_binder;
+	BuiltinPool &pool = builtin_binder.builtin_pools[p_type];
 	void *ptr = NULL;
 	ECMAScriptGCHandler *bind = NULL;
 	switch (p_type) {
 		case Variant::VECTOR2:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(Vector2));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, Vector2(*static_cast<const Vector2 *>(p_object)));
 			break;
 		case Variant::RECT2:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(Rect2));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, Rect2(*static_cast<const Rect2 *>(p_object)));
 			break;
 		case Variant::COLOR:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(Color));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, Color(*static_cast<const Color *>(p_object)));
 			break;
 		case Variant::VECTOR3:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(Vector3));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, Vector3(*static_cast<const Vector3 *>(p_object)));
 			break;
 		case Variant::BASIS:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(Basis));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, Basis(*static_cast<const Basis *>(p_object)));
 			break;
 		case Variant::QUAT:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(Quat));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, Quat(*static_cast<const Quat *>(p_object)));
 			break;
 		case Variant::PLANE:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(Plane));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, Plane(*static_cast<const Plane *>(p_object)));
 			break;
 		case Variant::TRANSFORM2D:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(Transform2D));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, Transform2D(*static_cast<const Transform2D *>(p_object)));
 			break;
 		case Variant::_RID:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(RID));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, RID(*static_cast<const RID *>(p_object)));
 			break;
 		case Variant::TRANSFORM:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(Transform));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, Transform(*static_cast<const Transform *>(p_object)));
 			break;
 		case Variant::AABB:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(AABB));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, AABB(*static_cast<const AABB *>(p_object)));
 			break;
 		case Variant::POOL_INT_ARRAY:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(PoolIntArray));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, PoolIntArray(*static_cast<const PoolIntArray *>(p_object)));
 			break;
 		case Variant::POOL_BYTE_ARRAY:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(PoolByteArray));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, PoolByteArray(*static_cast<const PoolByteArray *>(p_object)));
 			break;
 		case Variant::POOL_REAL_ARRAY:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(PoolRealArray));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, PoolRealArray(*static_cast<const PoolRealArray *>(p_object)));
 			break;
 		case Variant::POOL_COLOR_ARRAY:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(PoolColorArray));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, PoolColorArray(*static_cast<const PoolColorArray *>(p_object)));
 			break;
 		case Variant::POOL_STRING_ARRAY:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(PoolStringArray));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, PoolStringArray(*static_cast<const PoolStringArray *>(p_object)));
 			break;
 		case Variant::POOL_VECTOR2_ARRAY:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(PoolVector2Array));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, PoolVector2Array(*static_cast<const PoolVector2Array *>(p_object)));
 			break;
 		case Variant::POOL_VECTOR3_ARRAY:
-			ptr = memalloc(sizeof(ECMAScriptGCHandler) + sizeof(PoolVector3Array));
+			ptr = pool.alloc();
 			bind = memnew_placement(ptr, ECMAScriptGCHandler);
 			memnew_placement(bind + 1, PoolVector3Array(*static_cast<const PoolVector3Array *>(p_object)));
 			break;
@@ -125,12 +204,48 @@ void QuickJSBuiltinBinder::bind_builtin_object(JSContext *ctx, JSValue target, V
 #endif
 }
 
+// Small fixed-size values are stored in the same allocation as their JS object
+JSValue QuickJSBuiltinBinder::new_builtin_object(JSContext *ctx, JSValueConst p_prototype, Variant::Type p_type, const void *p_object) {
+	QuickJSBinder *binder = QuickJSBinder::get_context_binder(ctx);
+
+	JSValue obj = JS_UNDEFINED;
+	ECMAScriptGCHandler *bind = NULL;
+	switch (p_type) {
+#define NEW_INLINE_BUILTIN_OBJECT(m_type, m_class)                                                                                          \
+	case Variant::m_type:                                                                                                                   \
+		obj = JS_NewObjectProtoClassInline(ctx, p_prototype, binder->get_origin_class_id(), sizeof(ECMAScriptGCHandler) + sizeof(m_class)); \
+		if (JS_IsException(obj)) return obj;                                                                                                \
+		bind = memnew_placement(JS_GetOpaque(obj, binder->get_origin_class_id()), ECMAScriptGCHandler);                                     \
+		memnew_placement(bind + 1, m_class(*static_cast<const m_class *>(p_object)));                                                       \
+		break;
+		NEW_INLINE_BUILTIN_OBJECT(VECTOR2, Vector2)
+		NEW_INLINE_BUILTIN_OBJECT(VECTOR3, Vector3)
+		NEW_INLINE_BUILTIN_OBJECT(COLOR, Color)
+		NEW_INLINE_BUILTIN_OBJECT(QUAT, Quat)
+		NEW_INLINE_BUILTIN_OBJECT(RECT2, Rect2)
+		NEW_INLINE_BUILTIN_OBJECT(PLANE, Plane)
+#undef NEW_INLINE_BUILTIN_OBJECT
+		default:
+			obj = JS_NewObjectProtoClass(ctx, p_prototype, binder->get_origin_class_id());
+			bind_builtin_object(ctx, obj, p_type, p_object);
+			return obj;
+	}
+
+	bind->context = ctx;
+	bind->type = p_type;
+	bind->flags |= ECMAScriptGCHandler::FLAG_BUILTIN_CLASS | ECMAScriptGCHandler::FLAG_INLINE_STORAGE;
+	bind->godot_builtin_object_ptr = bind + 1;
+	bind->ecma_object = JS_VALUE_GET_PTR(obj);
+#ifdef DUMP_LEAKS
+	QuickJSBinder::add_debug_binding_info(ctx, obj, bind);
+#endif
+	return obj;
+}
+
 JSValue QuickJSBuiltinBinder::create_builtin_value(JSContext *ctx, Variant::Type p_type, const void *p_val) {
 	QuickJSBinder *binder = QuickJSBinder::get_context_binder(ctx);
 	const QuickJSBuiltinBinder::BuiltinClass &cls = binder->builtin_binder.get_class(p_type);
-	JSValue obj = JS_NewObjectProtoClass(ctx, cls.class_prototype, binder->get_origin_class_id());
-	bind_builtin_object(ctx, obj, p_type, p_val);
-	return obj;
+	return new_builtin_object(ctx, cls.class_prototype, p_type, p_val);
 }
 
 void QuickJSBuiltinBinder::builtin_finalizer(ECMAScriptGCHandler *p_bind) {
@@ -159,7 +274,9 @@ void QuickJSBuiltinBinder::builtin_finalizer(ECMAScriptGCHandler *p_bind) {
 		default:
 			break;
 	}
-	memdelete(p_bind);
+	if (!(p_bind->flags & ECMAScriptGCHandler::FLAG_INLINE_STORAGE)) {
+		builtin_pools[p_bind->type].free(p_bind);
+	}
 }
 
 void QuickJSBuiltinBinder::register_builtin_class(Variant::Type p_type, const char *p_name, JSConstructorFunc p_constructor, int argc) {
@@ -628,6 +745,132 @@ JSValue QuickJSBuiltinBinder::new_object_from(JSContext *ctx, const PoolVector3A
 	return create_builtin_value(ctx, Variant::POOL_VECTOR3_ARRAY, &p_val);
 }
 
+#ifdef REAL_T_IS_DOUBLE
+#define JS_REAL_TYPED_ARRAY "Float64Array"
+#else
+#define JS_REAL_TYPED_ARRAY "Float32Array"
+#endif
+
+// Keeps the memory of a PoolVector alive while an ArrayBuffer is viewing it
+struct PoolArrayBufferView {
+	virtual Variant get_array() const = 0;
+	virtual ~PoolArrayBufferView() {}
+};
+
+template <class T>
+struct PoolVectorArrayBufferView : public PoolArrayBufferView {
+	// Only a reference, a held lock would make resizing the array fail with ERR_LOCKED
+	PoolVector<T> array;
+	virtual Variant get_array() const { return array; }
+};
+
+static void pool_array_buffer_free(JSRuntime *rt, void *opaque, void *ptr) {
+	memdelete(static_cast<PoolArrayBufferView *>(opaque));
+}
+
+template <class T>
+static JSValue pool_vector_as_array_buffer(JSContext *ctx, const PoolVector<T> &p_array) {
+	PoolVectorArrayBufferView<T> *view = memnew(PoolVectorArrayBufferView<T>);
+	view->array = p_array;
+	// The reference makes later writes to the array copy it first, so the memory stays where it is
+	typename PoolVector<T>::Read r = view->array.read();
+	return JS_NewArrayBuffer(ctx, (uint8_t *)(r.ptr()), view->array.size() * sizeof(T), pool_array_buffer_free, view, false);
+}
+
+JSValue QuickJSBuiltinBinder::new_array_buffer(JSContext *ctx, const Variant &p_pool_array) {
+	switch (p_pool_array.get_type()) {
+		case Variant::POOL_BYTE_ARRAY:
+			return pool_vector_as_array_buffer<uint8_t>(ctx, p_pool_array);
+		case Variant::POOL_INT_ARRAY:
+			return pool_vector_as_array_buffer<int>(ctx, p_pool_array);
+		case Variant::POOL_REAL_ARRAY:
+			return pool_vector_as_array_buffer<real_t>(ctx, p_pool_array);
+		case Variant::POOL_VECTOR2_ARRAY:
+			return pool_vector_as_array_buffer<Vector2>(ctx, p_pool_array);
+		case Variant::POOL_VECTOR3_ARRAY:
+			return pool_vector_as_array_buffer<Vector3>(ctx, p_pool_array);
+		case Variant::POOL_COLOR_ARRAY:
+			return pool_vector_as_array_buffer<Color>(ctx, p_pool_array);
+		default:
+			ERR_FAIL_V(JS_ThrowTypeError(ctx, "Pool array expected"));
+	}
+}
+
+bool QuickJSBuiltinBinder::get_array_buffer_pool(JSValueConst p_buffer, Variant &r_pool_array) {
+	if (PoolArrayBufferView *view = static_cast<PoolArrayBufferView *>(JS_GetArrayBufferOpaque(p_buffer, pool_array_buffer_free))) {
+		r_pool_array = view->get_array();
+		return true;
+	}
+	return false;
+}
+
+template <class T>
+static JSValue pool_vector_as_typed_array(JSContext *ctx, PoolVector<T> *p_array, const char *p_typed_array_class) {
+	{ // Make sure the memory is not shared with other arrays before exposing it
+		typename PoolVector<T>::Write w = p_array->write();
+	}
+	JSValue buffer = pool_vector_as_array_buffer<T>(ctx, *p_array);
+	JSValue global_object = JS_GetGlobalObject(ctx);
+	JSValue constructor = JS_GetPropertyStr(ctx, global_object, p_typed_array_class);
+	JS_FreeValue(ctx, global_object);
+	JSValue ret = JS_CallConstructor(ctx, constructor, 1, &buffer);
+	JS_FreeValue(ctx, constructor);
+	JS_FreeValue(ctx, buffer);
+	if (JS_IsException(ret)) {
+		JS_FreeValue(ctx, JS_GetException(ctx));
+		ERR_FAIL_V(JS_ThrowTypeError(ctx, "Cannot create a %s view of the array", p_typed_array_class));
+	}
+	return ret;
+}
+
+template <class T>
+static JSValue pool_vector_from_typed_array(JSContext *ctx, PoolVector<T> *p_array, int argc, JSValueConst *argv) {
+	ERR_FAIL_COND_V(argc < 1, JS_ThrowTypeError(ctx, "TypedArray, DataView or ArrayBuffer expected for argument #0"));
+	size_t offset = 0;
+	size_t length = 0;
+	JSValue buffer = JS_UNDEFINED;
+	if (JS_IsTypedArray(argv[0])) {
+		buffer = JS_GetTypedArrayBuffer(ctx, argv[0], &offset, &length, NULL);
+		if (JS_IsException(buffer)) return buffer;
+	} else if (JS_IsDataView(argv[0])) {
+		// The byteLength getter throws for a detached buffer
+		int64_t view_offset = 0;
+		int64_t view_length = 0;
+		JSValue byte_offset = JS_GetPropertyStr(ctx, argv[0], "byteOffset");
+		JSValue byte_length = JS_GetPropertyStr(ctx, argv[0], "byteLength");
+		const bool valid = JS_ToInt64(ctx, &view_offset, byte_offset) == 0 && JS_ToInt64(ctx, &view_length, byte_length) == 0;
+		JS_FreeValue(ctx, byte_offset);
+		JS_FreeValue(ctx, byte_length);
+		if (!valid) return JS_EXCEPTION;
+		offset = view_offset;
+		length = view_length;
+		buffer = JS_GetPropertyStr(ctx, argv[0], "buffer");
+		if (JS_IsException(buffer)) return buffer;
+	} else if (JS_IsArrayBuffer(argv[0])) {
+		buffer = JS_DupValue(ctx, argv[0]);
+	} else {
+		return JS_ThrowTypeError(ctx, "TypedArray, DataView or ArrayBuffer expected for argument #0");
+	}
+	size_t size = 0;
+	uint8_t *data = JS_GetArrayBuffer(ctx, &size, buffer);
+	JS_FreeValue(ctx, buffer);
+	if (!data) return JS_EXCEPTION;
+	if (JS_IsArrayBuffer(argv[0])) length = size;
+	if (length % sizeof(T) != 0) {
+		return JS_ThrowRangeError(ctx, "Byte length %d is not a multiple of the element size %d", int(length), int(sizeof(T)));
+	}
+
+	int count = length / sizeof(T);
+	if (p_array->resize(count) != OK) {
+		return JS_ThrowRangeError(ctx, "Cannot resize the array to %d elements", count);
+	}
+	if (count) {
+		typename PoolVector<T>::Write w = p_array->write();
+		copymem(w.ptr(), data + offset, count * sizeof(T));
+	}
+	return JS_UNDEFINED;
+}
+
 void QuickJSBuiltinBinder::bind_builtin_propties_manually() {
 
 	{ // Color
@@ -1039,13 +1282,7 @@ void QuickJSBuiltinBinder::bind_builtin_propties_manually() {
 				"get_buffer",
 				[](JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
 					ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, this_val);
-					PoolByteArray *array = memnew(PoolByteArray(*bind->getPoolByteArray()));
-					JSValue ret = JS_NewArrayBuffer(
-							ctx, const_cast<uint8_t *>(array->read().ptr()), array->size(), [](JSRuntime *rt, void *opaque, void *ptr) {
-								memdelete(static_cast<PoolByteArray *>(opaque));
-							},
-							array, false);
-					return ret;
+					return pool_vector_as_array_buffer<uint8_t>(ctx, *bind->getPoolByteArray());
 				},
 				0);
 	}
@@ -1056,13 +1293,7 @@ void QuickJSBuiltinBinder::bind_builtin_propties_manually() {
 				"get_buffer",
 				[](JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
 					ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, this_val);
-					PoolIntArray *array = memnew(PoolIntArray(*bind->getPoolIntArray()));
-					JSValue ret = JS_NewArrayBuffer(
-							ctx, (uint8_t *)(array->read().ptr()), array->size() * sizeof(int), [](JSRuntime *rt, void *opaque, void *ptr) {
-								memdelete(static_cast<PoolIntArray *>(opaque));
-							},
-							array, false);
-					return ret;
+					return pool_vector_as_array_buffer<int>(ctx, *bind->getPoolIntArray());
 				},
 				0);
 	}
@@ -1073,13 +1304,7 @@ void QuickJSBuiltinBinder::bind_builtin_propties_manually() {
 				"get_buffer",
 				[](JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
 					ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, this_val);
-					PoolRealArray *array = memnew(PoolRealArray(*bind->getPoolRealArray()));
-					JSValue ret = JS_NewArrayBuffer(
-							ctx, (uint8_t *)(array->read().ptr()), array->size() * sizeof(real_t), [](JSRuntime *rt, void *opaque, void *ptr) {
-								memdelete(static_cast<PoolRealArray *>(opaque));
-							},
-							array, false);
-					return ret;
+					return pool_vector_as_array_buffer<real_t>(ctx, *bind->getPoolRealArray());
 				},
 				0);
 	}
@@ -1090,13 +1315,7 @@ void QuickJSBuiltinBinder::bind_builtin_propties_manually() {
 				"get_buffer",
 				[](JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
 					ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, this_val);
-					PoolVector2Array *array = memnew(PoolVector2Array(*bind->getPoolVector2Array()));
-					JSValue ret = JS_NewArrayBuffer(
-							ctx, (uint8_t *)(array->read().ptr()), array->size() * sizeof(Vector2), [](JSRuntime *rt, void *opaque, void *ptr) {
-								memdelete(static_cast<PoolVector2Array *>(opaque));
-							},
-							array, false);
-					return ret;
+					return pool_vector_as_array_buffer<Vector2>(ctx, *bind->getPoolVector2Array());
 				},
 				0);
 	}
@@ -1108,13 +1327,7 @@ void QuickJSBuiltinBinder::bind_builtin_propties_manually() {
 				"get_buffer",
 				[](JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
 					ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, this_val);
-					PoolVector3Array *array = memnew(PoolVector3Array(*bind->getPoolVector3Array()));
-					JSValue ret = JS_NewArrayBuffer(
-							ctx, (uint8_t *)(array->read().ptr()), array->size() * sizeof(Vector3), [](JSRuntime *rt, void *opaque, void *ptr) {
-								memdelete(static_cast<PoolVector3Array *>(opaque));
-							},
-							array, false);
-					return ret;
+					return pool_vector_as_array_buffer<Vector3>(ctx, *bind->getPoolVector3Array());
 				},
 				0);
 	}
@@ -1126,14 +1339,31 @@ void QuickJSBuiltinBinder::bind_builtin_propties_manually() {
 				"get_buffer",
 				[](JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
 					ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, this_val);
-					PoolColorArray *array = memnew(PoolColorArray(*bind->getPoolColorArray()));
-					JSValue ret = JS_NewArrayBuffer(
-							ctx, (uint8_t *)(array->read().ptr()), array->size() * sizeof(Color), [](JSRuntime *rt, void *opaque, void *ptr) {
-								memdelete(static_cast<PoolColorArray *>(opaque));
-							},
-							array, false);
-					return ret;
+					return pool_vector_as_array_buffer<Color>(ctx, *bind->getPoolColorArray());
 				},
 				0);
 	}
+
+#define REGISTER_POOL_ARRAY_TYPED_VIEWS(m_type, m_class, m_element, m_typed_array)                                                   \
+	binder->get_builtin_binder().register_method(                                                                                     \
+			Variant::m_type, "as_typed_array", [](JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {              \
+				ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, this_val);                                                      \
+				return pool_vector_as_typed_array<m_element>(ctx, bind->get##m_class(), m_typed_array);                              \
+			},                                                                                                                        \
+			0);                                                                                                                       \
+	binder->get_builtin_binder().register_method(                                                                                     \
+			Variant::m_type, "from_typed_array", [](JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {            \
+				ECMAScriptGCHandler *bind = BINDING_DATA_FROM_JS(ctx, this_val);                                                      \
+				return pool_vector_from_typed_array<m_element>(ctx, bind->get##m_class(), argc, argv);                               \
+			},                                                                                                                        \
+			1)
+
+	// PoolXXXArray.prototype.as_typed_array PoolXXXArray.prototype.from_typed_array
+	REGISTER_POOL_ARRAY_TYPED_VIEWS(POOL_BYTE_ARRAY, PoolByteArray, uint8_t, "Uint8Array");
+	REGISTER_POOL_ARRAY_TYPED_VIEWS(POOL_INT_ARRAY, PoolIntArray, int, "Int32Array");
+	REGISTER_POOL_ARRAY_TYPED_VIEWS(POOL_REAL_ARRAY, PoolRealArray, real_t, JS_REAL_TYPED_ARRAY);
+	REGISTER_POOL_ARRAY_TYPED_VIEWS(POOL_VECTOR2_ARRAY, PoolVector2Array, Vector2, JS_REAL_TYPED_ARRAY);
+	REGISTER_POOL_ARRAY_TYPED_VIEWS(POOL_VECTOR3_ARRAY, PoolVector3Array, Vector3, JS_REAL_TYPED_ARRAY);
+	REGISTER_POOL_ARRAY_TYPED_VIEWS(POOL_COLOR_ARRAY, PoolColorArray, Color, "Float32Array");
+#undef REGISTER_POOL_ARRAY_TYPED_VIEWS
 }
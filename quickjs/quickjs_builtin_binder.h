@@ -2,6 +2,7 @@
 #define QUICKJS_BUILTIN_BINDER_H
 
 #include "quickjs/quickjs.h"
+#include <core/list.h>
 #include <core/variant.h>
 struct ECMAScriptGCHandler;
 class QuickJSBinder;
@@ -18,10 +19,28 @@ public:
 		JSClassDef js_class;
 	};
 
+	// Free-list allocator recycling the binding blocks of one builtin type
+	struct BuiltinPool {
+		enum {
+			SLAB_BLOCK_COUNT = 64,
+		};
+		size_t block_size;
+		void *free_list;
+		List<void *> slabs;
+		uint32_t live_count;
+		uint32_t peak_count;
+
+		void *alloc();
+		void free(void *p_block);
+		void clear();
+		BuiltinPool();
+	};
+
 private:
 	QuickJSBinder *binder;
 	JSContext *ctx;
 	BuiltinClass *builtin_class_map;
+	BuiltinPool *builtin_pools;
 	JSValue to_string_function;
 	JSAtom js_key_to_string;
 
@@ -41,6 +60,10 @@ public:
 
 	void initialize(JSContext *p_context, QuickJSBinder *p_binder);
 	void uninitialize();
+	void release_pools();
+
+	_FORCE_INLINE_ uint32_t get_pool_live_count(Variant::Type p_type) const { return builtin_pools[p_type].live_count; }
+	_FORCE_INLINE_ uint32_t get_pool_peak_count(Variant::Type p_type) const { return builtin_pools[p_type].peak_count; }
 
 	void bind_builtin_classes_gen();
 	void bind_builtin_propties_manually();
@@ -50,8 +73,13 @@ public:
 	_FORCE_INLINE_ BuiltinClass &get_class(Variant::Type p_type) { return *(builtin_class_map + p_type); }
 
 	static void bind_builtin_object(JSContext *ctx, JSValue target, Variant::Type p_type, const void *p_object);
+	static JSValue new_builtin_object(JSContext *ctx, JSValueConst p_prototype, Variant::Type p_type, const void *p_object);
 	static JSValue create_builtin_value(JSContext *ctx, Variant::Type p_type, const void *p_val);
 	static JSValue new_object_from(JSContext *ctx, const Variant &p_val);
+	// ArrayBuffer viewing the memory of a pool array without copying it
+	static JSValue new_array_buffer(JSContext *ctx, const Variant &p_pool_array);
+	// Gets the pool array behind an ArrayBuffer created by new_array_buffer
+	static bool get_array_buffer_pool(JSValueConst p_buffer, Variant &r_pool_array);
 	static JSValue new_object_from(JSContext *ctx, const Vector2 &p_val);
 	static JSValue new_object_from(JSContext *ctx, const Vector3 &p_val);
 	static JSValue new_object_from(JSContext *ctx, const Rect2 &p_val);
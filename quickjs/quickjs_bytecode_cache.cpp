@@ -0,0 +1,82 @@
+#include "quickjs_bytecode_cache.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "quickjs/quickjs.h"
+#ifdef TOOLS_ENABLED
+#include "editor/editor_settings.h"
+#endif
+
+String QuickJSBytecodeCache::get_cache_dir() {
+#ifdef TOOLS_ENABLED
+	if (EditorSettings::get_singleton()) {
+		return EditorSettings::get_singleton()->get_cache_dir().plus_file("ecmascript");
+	}
+#endif
+	return "user://.ecmascript_cache";
+}
+
+String QuickJSBytecodeCache::get_cache_path(const String &p_file, const String &p_code) {
+	return get_cache_dir().plus_file((p_file + "\n" + p_code).md5_text() + ".jsc");
+}
+
+uint32_t QuickJSBytecodeCache::get_build_stamp() {
+	String stamp;
+#ifdef QUICKJS_CONFIG_VERSION
+	stamp += QUICKJS_CONFIG_VERSION;
+#endif
+#ifdef CONFIG_BIGNUM
+	stamp += "|bignum";
+#endif
+#ifdef JS_NAN_BOXING
+	stamp += "|nan-boxing";
+#endif
+#ifdef QUICKJS_WITH_DEBUGGER
+	stamp += "|debugger";
+#endif
+	stamp += "|" + itos(sizeof(void *));
+	return stamp.hash();
+}
+
+Error QuickJSBytecodeCache::load(const String &p_file, const String &p_code, Vector<uint8_t> &r_bytecode) {
+	FileAccessRef f = FileAccess::open(get_cache_path(p_file, p_code), FileAccess::READ);
+	if (!f) {
+		return ERR_FILE_NOT_FOUND;
+	}
+	ERR_FAIL_COND_V(f->get_len() < HEADER_SIZE, ERR_FILE_CORRUPT);
+	if (f->get_32() != HEADER_MAGIC || f->get_32() != get_build_stamp()) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (f->get_32() != uint32_t(p_code.length())) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	const uint32_t size = f->get_32();
+	ERR_FAIL_COND_V(size == 0 || size != f->get_len() - HEADER_SIZE, ERR_FILE_CORRUPT);
+	r_bytecode.resize(size);
+	ERR_FAIL_COND_V(f->get_buffer(r_bytecode.ptrw(), size) != size, ERR_FILE_CORRUPT);
+	return OK;
+}
+
+Error QuickJSBytecodeCache::save(const String &p_file, const String &p_code, const uint8_t *p_bytecode, size_t p_size) {
+	const String dir = get_cache_dir();
+	if (!DirAccess::exists(dir)) {
+		DirAccessRef da = DirAccess::create_for_path(dir);
+		ERR_FAIL_COND_V(da->make_dir_recursive(dir) != OK, ERR_CANT_CREATE);
+	}
+	FileAccessRef f = FileAccess::open(get_cache_path(p_file, p_code), FileAccess::WRITE);
+	ERR_FAIL_COND_V(!f, ERR_CANT_CREATE);
+	f->store_32(HEADER_MAGIC);
+	f->store_32(get_build_stamp());
+	f->store_32(p_code.length());
+	f->store_32(p_size);
+	f->store_buffer(p_bytecode, p_size);
+	return OK;
+}
+
+Error QuickJSBytecodeCache::remove(const String &p_file, const String &p_code) {
+	const String path = get_cache_path(p_file, p_code);
+	if (!FileAccess::exists(path)) {
+		return OK;
+	}
+	DirAccessRef da = DirAccess::create_for_path(path);
+	return da->remove(path);
+}
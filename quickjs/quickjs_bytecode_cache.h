@@ -0,0 +1,26 @@
+#ifndef QUICKJS_BYTECODE_CACHE_H
+#define QUICKJS_BYTECODE_CACHE_H
+
+#include "core/ustring.h"
+#include "core/vector.h"
+
+// On-disk cache of compiled module bytecode keyed by the module path and source content
+class QuickJSBytecodeCache {
+public:
+	enum {
+		HEADER_MAGIC = 0x4342534A, // "JSBC"
+		HEADER_SIZE = 16,
+	};
+
+	static String get_cache_dir();
+	static String get_cache_path(const String &p_file, const String &p_code);
+	// Build configuration that must match for cached bytecode to be readable
+	static uint32_t get_build_stamp();
+
+	static Error load(const String &p_file, const String &p_code, Vector<uint8_t> &r_bytecode);
+	static Error save(const String &p_file, const String &p_code, const uint8_t *p_bytecode, size_t p_size);
+	// Drops an entry that could not be read back
+	static Error remove(const String &p_file, const String &p_code);
+};
+
+#endif // QUICKJS_BYTECODE_CACHE_H
@@ -0,0 +1,188 @@
+#include "quickjs_class_table.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+
+Mutex *QuickJSClassTable::mutex = NULL;
+QuickJSClassTable *QuickJSClassTable::singleton = NULL;
+int QuickJSClassTable::users = 0;
+
+// Looks the method up in the class that declares it, the signature is dropped if the binding disagrees with it
+const QuickJSClassTable::MethodSignature *QuickJSClassTable::find_signature(const HashMap<String, const MethodSignature *> &p_signatures, const ClassDB::ClassInfo *p_class, const MethodBind *p_bind) {
+	if (p_bind->is_vararg()) return NULL;
+	const MethodSignature *signature = NULL;
+	for (const ClassDB::ClassInfo *cls = p_class; cls && !signature; cls = cls->inherits_ptr) {
+		if (const MethodSignature *const *found = p_signatures.getptr(String(cls->name) + "." + String(p_bind->get_name()))) {
+			signature = *found;
+		}
+	}
+	if (!signature) return NULL;
+	if (signature->argument_count != p_bind->get_argument_count() || (signature->return_type != Variant::NIL) != p_bind->has_return()) {
+		print_verbose(vformat("ECMAScript: ignored the outdated signature of %s.%s", signature->class_name, signature->name));
+		return NULL;
+	}
+#ifdef DEBUG_METHODS_ENABLED
+	bool matches = !p_bind->has_return() || p_bind->get_argument_type(-1) == signature->return_type;
+	for (int i = 0; matches && i < signature->argument_count; i++) {
+		matches = p_bind->get_argument_type(i) == SIGNATURE_ARGUMENT_TYPES[signature->argument_begin + i];
+	}
+	if (!matches) {
+		print_verbose(vformat("ECMAScript: ignored the outdated signature of %s.%s", signature->class_name, signature->name));
+		return NULL;
+	}
+#endif
+	return signature;
+}
+
+void QuickJSClassTable::build(const Map<String, const char *> &p_class_remap) {
+	HashMap<String, const MethodSignature *> signatures;
+	for (int i = 0; i < METHOD_SIGNATURE_COUNT; i++) {
+		signatures.set(String(METHOD_SIGNATURES[i].class_name) + "." + METHOD_SIGNATURES[i].name, &METHOD_SIGNATURES[i]);
+	}
+
+	for (const StringName *key = ClassDB::classes.next(NULL); key; key = ClassDB::classes.next(key)) {
+		const ClassDB::ClassInfo *gdclass = ClassDB::classes.getptr(*key);
+
+		Class cls;
+		cls.gdclass = gdclass;
+		cls.base = -1;
+		if (const Map<String, const char *>::Element *E = p_class_remap.find(gdclass->name)) {
+			cls.name = E->get();
+		} else {
+			cls.name = String(gdclass->name).ascii();
+		}
+		if (cls.name.length() == 0) continue;
+
+		// methods
+		HashMap<StringName, int> method_ids;
+		cls.method_begin = methods.size();
+		for (const StringName *method_key = gdclass->method_map.next(NULL); method_key; method_key = gdclass->method_map.next(method_key)) {
+			Method method;
+			method.name = String(*method_key).ascii();
+			method.bind = gdclass->method_map.get(*method_key);
+			method.signature = find_signature(signatures, gdclass, method.bind);
+			method_ids.set(*method_key, methods.size());
+			methods.push_back(method);
+		}
+		cls.method_count = methods.size() - cls.method_begin;
+
+		// properties, accessors that are not methods of the class get their own method ids
+		cls.property_begin = properties.size();
+		for (const StringName *prop_key = gdclass->property_setget.next(NULL); prop_key; prop_key = gdclass->property_setget.next(prop_key)) {
+			const ClassDB::PropertySetGet &prop = gdclass->property_setget[*prop_key];
+			Property property;
+			property.name = *prop_key;
+			property.getter = -1;
+			property.setter = -1;
+			property.indexed = -1;
+			if (prop.index >= 0) {
+				property.indexed = indexed_properties.size();
+				indexed_properties.push_back(&prop);
+			} else {
+				if (const int *id = method_ids.getptr(prop.setter)) {
+					property.setter = *id;
+				} else if (prop._setptr) {
+					Method method;
+					method.name = String(prop.setter).ascii();
+					method.bind = prop._setptr;
+					method.signature = find_signature(signatures, gdclass, method.bind);
+					property.setter = methods.size();
+					methods.push_back(method);
+				}
+				if (const int *id = method_ids.getptr(prop.getter)) {
+					property.getter = *id;
+				} else if (prop._getptr) {
+					Method method;
+					method.name = String(prop.getter).ascii();
+					method.bind = prop._getptr;
+					method.signature = find_signature(signatures, gdclass, method.bind);
+					property.getter = methods.size();
+					methods.push_back(method);
+				}
+			}
+			properties.push_back(property);
+		}
+		cls.property_count = properties.size() - cls.property_begin;
+
+		// constants
+		cls.constant_begin = constants.size();
+		for (const StringName *const_key = gdclass->constant_map.next(NULL); const_key; const_key = gdclass->constant_map.next(const_key)) {
+			Constant constant;
+			constant.name = *const_key;
+			constant.value = gdclass->constant_map.get(*const_key);
+			constants.push_back(constant);
+		}
+		cls.constant_count = constants.size() - cls.constant_begin;
+
+		// enumerations
+		cls.enum_begin = enums.size();
+		for (const StringName *enum_key = gdclass->enum_map.next(NULL); enum_key; enum_key = gdclass->enum_map.next(enum_key)) {
+			Enum enumeration;
+			enumeration.name = *enum_key;
+			enumeration.constant_begin = enum_constants.size();
+			const List<StringName> &const_keys = gdclass->enum_map.get(*enum_key);
+			for (const List<StringName>::Element *E = const_keys.front(); E; E = E->next()) {
+				Constant constant;
+				constant.name = E->get();
+				constant.value = gdclass->constant_map.get(E->get());
+				enum_constants.push_back(constant);
+			}
+			enumeration.constant_count = enum_constants.size() - enumeration.constant_begin;
+			enums.push_back(enumeration);
+		}
+		cls.enum_count = enums.size() - cls.enum_begin;
+
+		// signals
+		cls.signal_begin = signals.size();
+		for (const StringName *signal_key = gdclass->signal_map.next(NULL); signal_key; signal_key = gdclass->signal_map.next(signal_key)) {
+			signals.push_back(*signal_key);
+		}
+		cls.signal_count = signals.size() - cls.signal_begin;
+
+		cls.class_id = 0;
+		JS_NewClassID(&cls.class_id);
+		class_indices.set(gdclass->name, classes.size());
+		classes.push_back(cls);
+	}
+
+	// Classes whose base is not in the table inherit from GodotOrigin directly
+	for (int i = 0; i < classes.size(); i++) {
+		const ClassDB::ClassInfo *base = classes[i].gdclass->inherits_ptr;
+		if (base) {
+			if (const int *base_index = class_indices.getptr(base->name)) {
+				classes.write[i].base = *base_index;
+			}
+		}
+	}
+}
+
+const QuickJSClassTable *QuickJSClassTable::acquire(const Map<String, const char *> &p_class_remap) {
+	MutexLock lock(mutex);
+	if (singleton == NULL) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		singleton = memnew(QuickJSClassTable);
+		singleton->build(p_class_remap);
+		print_verbose(vformat("ECMAScript: built binding table of %d classes and %d methods in %.2f ms", singleton->classes.size(), singleton->methods.size(), (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0));
+	}
+	++users;
+	return singleton;
+}
+
+void QuickJSClassTable::release() {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND(users <= 0);
+	// The table is kept until finalize() as its class ids can't be given back to QuickJS
+	--users;
+}
+
+void QuickJSClassTable::initialize() {
+	mutex = Mutex::create();
+}
+
+void QuickJSClassTable::finalize() {
+	if (singleton) {
+		memdelete(singleton);
+		singleton = NULL;
+	}
+	memdelete(mutex);
+	mutex = NULL;
+}
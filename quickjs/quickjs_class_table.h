@@ -0,0 +1,104 @@
+#ifndef QUICKJS_CLASS_TABLE_H
+#define QUICKJS_CLASS_TABLE_H
+
+#include "core/class_db.h"
+#include "core/hash_map.h"
+#include "core/map.h"
+#include "core/os/mutex.h"
+#include "core/vector.h"
+#include "quickjs/quickjs.h"
+
+// Runtime independent binding metadata, built once from ClassDB and shared by every binder
+class QuickJSClassTable {
+public:
+	// Argument and return types of a bound method, generated from the class reference so release builds have them too
+	struct MethodSignature {
+		const char *class_name;
+		const char *name;
+		// NIL when the method returns nothing
+		Variant::Type return_type;
+		int argument_count;
+		// Index of the first argument in SIGNATURE_ARGUMENT_TYPES
+		int argument_begin;
+	};
+
+	struct Method {
+		CharString name;
+		MethodBind *bind;
+		// NULL when the arguments can't be passed through ptrcall
+		const MethodSignature *signature;
+	};
+
+	struct Property {
+		StringName name;
+		// Method ids of the accessors, -1 when there is none
+		int getter;
+		int setter;
+		// Indexed property id, -1 for plain properties
+		int indexed;
+	};
+
+	struct Constant {
+		StringName name;
+		int value;
+	};
+
+	struct Enum {
+		StringName name;
+		int constant_begin;
+		int constant_count;
+	};
+
+	// Each range indexes the matching table below
+	struct Class {
+		const ClassDB::ClassInfo *gdclass;
+		CharString name;
+		// Allocated once so every runtime registers the class under the same id
+		JSClassID class_id;
+		// Class index of the base class, -1 for roots
+		int base;
+		int method_begin;
+		int method_count;
+		int property_begin;
+		int property_count;
+		int constant_begin;
+		int constant_count;
+		int enum_begin;
+		int enum_count;
+		int signal_begin;
+		int signal_count;
+	};
+
+	Vector<Class> classes;
+	HashMap<StringName, int> class_indices;
+	// Indexed by method id, which is also the magic of the bound JS function
+	Vector<Method> methods;
+	Vector<const ClassDB::PropertySetGet *> indexed_properties;
+	Vector<Property> properties;
+	Vector<Constant> constants;
+	Vector<Enum> enums;
+	Vector<Constant> enum_constants;
+	Vector<StringName> signals;
+
+	static const Variant::Type SIGNATURE_ARGUMENT_TYPES[];
+	static const MethodSignature METHOD_SIGNATURES[];
+	static const int METHOD_SIGNATURE_COUNT;
+
+private:
+	static Mutex *mutex;
+	static QuickJSClassTable *singleton;
+	static int users;
+
+	void build(const Map<String, const char *> &p_class_remap);
+	static const MethodSignature *find_signature(const HashMap<String, const MethodSignature *> &p_signatures, const ClassDB::ClassInfo *p_class, const MethodBind *p_bind);
+
+public:
+	// Classes remapped to an empty name are left out of the table
+	static const QuickJSClassTable *acquire(const Map<String, const char *> &p_class_remap);
+	static void release();
+
+	static void initialize();
+	static void finalize();
+};
+
+#endif // QUICKJS_CLASS_TABLE_H
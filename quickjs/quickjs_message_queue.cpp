@@ -0,0 +1,126 @@
+#include "quickjs_message_queue.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/typedefs.h"
+#include <chrono>
+
+void QuickJSMessageQueue::setup(uint32_t p_capacity) {
+	ERR_FAIL_COND(buffer != NULL);
+	capacity = next_power_of_2(MAX(p_capacity, 1u));
+	mask = capacity - 1;
+	buffer = memnew_arr(Variant, capacity);
+	post_times = memnew_arr(uint64_t, capacity);
+}
+
+bool QuickJSMessageQueue::try_push(const Variant &p_message) {
+	if (atomic_add(&count, 0) >= capacity) {
+		return false;
+	}
+	buffer[write_pos] = p_message;
+	post_times[write_pos] = OS::get_singleton()->get_ticks_usec();
+	write_pos = (write_pos + 1) & mask;
+	// Publishes the slot to the consumer
+	const uint32_t queued = atomic_increment(&count);
+	atomic_exchange_if_greater(&peak, queued);
+	atomic_increment(&posted);
+	return true;
+}
+
+bool QuickJSMessageQueue::push_wait(const Variant &p_message, uint64_t p_timeout_usec) {
+	if (try_push(p_message)) {
+		return true;
+	}
+	std::unique_lock<std::mutex> lock(room_mutex);
+	// Registered before checking again, so a consumer freeing slots from now on notifies
+	atomic_increment(&waiting_producers);
+	const bool pushed = room_condition.wait_for(lock, std::chrono::microseconds(p_timeout_usec), [&] { return try_push(p_message); });
+	atomic_decrement(&waiting_producers);
+	return pushed;
+}
+
+void QuickJSMessageQueue::notify_room() {
+	if (atomic_add(&waiting_producers, 0) == 0) {
+		return;
+	}
+	{ // The producer either sees the freed slots or is already waiting
+		std::lock_guard<std::mutex> lock(room_mutex);
+	}
+	room_condition.notify_all();
+}
+
+int QuickJSMessageQueue::pop_all(Vector<Variant> &r_messages) {
+	const uint32_t available = atomic_add(&count, 0);
+	r_messages.resize(available);
+	if (available == 0) {
+		return 0;
+	}
+	Variant *w = r_messages.ptrw();
+	const uint64_t now = OS::get_singleton()->get_ticks_usec();
+	uint64_t latency = 0;
+	for (uint32_t i = 0; i < available; i++) {
+		w[i] = buffer[read_pos];
+		buffer[read_pos] = Variant();
+		const uint64_t elapsed = now - post_times[read_pos];
+		latency += elapsed;
+		atomic_exchange_if_greater(&max_latency, elapsed);
+		read_pos = (read_pos + 1) & mask;
+	}
+	atomic_add(&total_latency, latency);
+	// Hands the slots back to the producer
+	atomic_sub(&count, available);
+	atomic_add(&delivered, uint64_t(available));
+	notify_room();
+	return available;
+}
+
+int QuickJSMessageQueue::discard_all() {
+	const uint32_t available = atomic_add(&count, 0);
+	for (uint32_t i = 0; i < available; i++) {
+		buffer[read_pos] = Variant();
+		read_pos = (read_pos + 1) & mask;
+	}
+	atomic_sub(&count, available);
+	atomic_add(&dropped, uint64_t(available));
+	notify_room();
+	return available;
+}
+
+Dictionary QuickJSMessageQueue::get_stats() {
+	Dictionary stats;
+	stats["capacity"] = capacity;
+	stats["queued"] = size();
+	stats["peak"] = atomic_add(&peak, 0u);
+	stats["posted"] = atomic_add(&posted, uint64_t(0));
+	const uint64_t delivered_count = atomic_add(&delivered, uint64_t(0));
+	stats["delivered"] = delivered_count;
+	stats["dropped"] = atomic_add(&dropped, uint64_t(0));
+	stats["blocked"] = atomic_add(&blocked, uint64_t(0));
+	stats["latency_avg_usec"] = delivered_count ? atomic_add(&total_latency, uint64_t(0)) / delivered_count : 0;
+	stats["latency_max_usec"] = atomic_add(&max_latency, uint64_t(0));
+	return stats;
+}
+
+QuickJSMessageQueue::QuickJSMessageQueue() {
+	buffer = NULL;
+	post_times = NULL;
+	capacity = 0;
+	mask = 0;
+	write_pos = 0;
+	read_pos = 0;
+	count = 0;
+	posted = 0;
+	delivered = 0;
+	dropped = 0;
+	blocked = 0;
+	peak = 0;
+	total_latency = 0;
+	max_latency = 0;
+	waiting_producers = 0;
+}
+
+QuickJSMessageQueue::~QuickJSMessageQueue() {
+	if (buffer) {
+		memdelete_arr(buffer);
+		memdelete_arr(post_times);
+	}
+}
@@ -0,0 +1,61 @@
+#ifndef QUICKJS_MESSAGE_QUEUE_H
+#define QUICKJS_MESSAGE_QUEUE_H
+
+#include "core/dictionary.h"
+#include "core/safe_refcount.h"
+#include "core/variant.h"
+#include "core/vector.h"
+#include <condition_variable>
+#include <mutex>
+
+// Bounded single producer, single consumer ring buffer of Worker messages
+class QuickJSMessageQueue {
+	Variant *buffer;
+	// When each queued message was posted
+	uint64_t *post_times;
+	uint32_t capacity;
+	uint32_t mask;
+	// Only touched by the producer and the consumer respectively
+	uint32_t write_pos;
+	uint32_t read_pos;
+	volatile uint32_t count;
+
+	volatile uint64_t posted;
+	volatile uint64_t delivered;
+	volatile uint64_t dropped;
+	volatile uint64_t blocked;
+	volatile uint32_t peak;
+	// Time from posting to delivery
+	volatile uint64_t total_latency;
+	volatile uint64_t max_latency;
+
+	// A producer waiting for room is parked here until the consumer frees slots
+	std::mutex room_mutex;
+	std::condition_variable room_condition;
+	volatile uint32_t waiting_producers;
+	void notify_room();
+
+public:
+	// The capacity is rounded up to a power of two, it is the high-water mark of the queue
+	void setup(uint32_t p_capacity);
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() { return atomic_add(&count, 0); }
+
+	// Producer side, fails when the queue is full
+	bool try_push(const Variant &p_message);
+	// Producer side, waits up to the timeout for the consumer to make room
+	bool push_wait(const Variant &p_message, uint64_t p_timeout_usec);
+	_FORCE_INLINE_ void record_dropped() { atomic_increment(&dropped); }
+	_FORCE_INLINE_ void record_blocked() { atomic_increment(&blocked); }
+	// Consumer side, moves every queued message out in one batch
+	int pop_all(Vector<Variant> &r_messages);
+	// Consumer side, releases every queued message when nobody listens for them
+	int discard_all();
+
+	Dictionary get_stats();
+
+	QuickJSMessageQueue();
+	~QuickJSMessageQueue();
+};
+
+#endif // QUICKJS_MESSAGE_QUEUE_H
@@ -0,0 +1,232 @@
+#include "quickjs_module_prefetcher.h"
+#include "../ecmascript.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "quickjs_binder.h"
+#include "quickjs_bytecode_cache.h"
+#include "quickjs_module_resolver.h"
+
+#define MAX_PREFETCH_THREADS 8
+
+Mutex *QuickJSModulePrefetcher::mutex = NULL;
+Semaphore *QuickJSModulePrefetcher::semaphore = NULL;
+List<QuickJSModulePrefetcher::Task> QuickJSModulePrefetcher::queue;
+Vector<Thread *> QuickJSModulePrefetcher::threads;
+bool QuickJSModulePrefetcher::exiting = false;
+
+bool QuickJSModulePrefetcher::can_prefetch(const String &p_file) {
+	const String extension = p_file.get_extension();
+	if (extension != EXT_JSMODULE && extension != EXT_JSCLASS && extension != EXT_JSON) return false;
+	return !ResourceFormatLoaderECMAScriptModule::has_bundled_module(p_file);
+}
+
+// Matches the default module name normalization of QuickJS
+String QuickJSModulePrefetcher::normalize_specifier(const String &p_base_file, const String &p_specifier) {
+	if (p_specifier.begins_with(".")) {
+		return p_base_file.get_base_dir().plus_file(p_specifier).simplify_path();
+	}
+	return p_specifier;
+}
+
+void QuickJSModulePrefetcher::resolve_imports(const String &p_file, const List<String> &p_imports, List<String> *r_files) {
+	for (const List<String>::Element *E = p_imports.front(); E; E = E->next()) {
+		String file = QuickJSModuleResolver::resolve(normalize_specifier(p_file, E->get()));
+		if (!file.empty()) {
+			r_files->push_back(file);
+		}
+	}
+}
+
+// Must be called with the mutex locked
+void QuickJSModulePrefetcher::enqueue(Graph *p_graph, const String &p_file) {
+	if (p_graph->seen.has(p_file)) return;
+	p_graph->seen.insert(p_file);
+	if (!can_prefetch(p_file) || p_graph->cached.has(p_file)) return;
+	Task task;
+	task.graph = p_graph;
+	task.file = p_file;
+	queue.push_back(task);
+	++p_graph->pending;
+	semaphore->post();
+}
+
+void QuickJSModulePrefetcher::delete_graph(Graph *p_graph) {
+	memdelete(p_graph->progress);
+	memdelete(p_graph);
+}
+
+void QuickJSModulePrefetcher::thread_main(void *p_userdata) {
+	JSContext *ctx = NULL;
+	while (true) {
+		semaphore->wait();
+		Task task;
+		bool use_bytecode_cache = false;
+		{
+			MutexLock lock(mutex);
+			if (exiting) break;
+			if (queue.empty()) continue;
+			task = queue.front()->get();
+			queue.pop_front();
+			task.graph->compiling.insert(task.file);
+			use_bytecode_cache = task.graph->use_bytecode_cache;
+		}
+		Graph *graph = task.graph;
+		const String &file = task.file;
+
+		Module module;
+		Error err = OK;
+		module.source = FileAccess::get_file_as_string(file, &err);
+		if (file.ends_with("." EXT_JSON)) {
+			module.source = "export default " + module.source;
+		}
+
+		List<String> imports;
+		if (err == OK) {
+			if (!ctx) ctx = QuickJSBinder::new_standalone_context();
+			if (use_bytecode_cache && QuickJSBytecodeCache::load(file, module.source, module.bytecode) == OK) {
+				err = QuickJSBinder::read_module_imports(ctx, module.bytecode, &imports);
+			} else {
+				ECMAscriptScriptError script_error;
+				err = QuickJSBinder::compile_module_standalone(ctx, module.source, file, module.bytecode, &script_error, &imports);
+				if (err == OK && use_bytecode_cache) {
+					QuickJSBytecodeCache::save(file, module.source, module.bytecode.ptr(), module.bytecode.size());
+				}
+			}
+		}
+
+		List<String> dependencies;
+		resolve_imports(file, imports, &dependencies);
+
+		MutexLock lock(mutex);
+		graph->compiling.erase(file);
+		if (!graph->released) {
+			// Modules that fail here are compiled again on the owning context, which reports the error
+			if (err == OK) {
+				graph->modules.set(file, module);
+			}
+			for (List<String>::Element *E = dependencies.front(); E; E = E->next()) {
+				enqueue(graph, E->get());
+			}
+			if (graph->waiting_for == file) {
+				graph->progress->post();
+			}
+		}
+		if (--graph->pending == 0 && graph->released) {
+			delete_graph(graph);
+		}
+	}
+	if (ctx) {
+		QuickJSBinder::free_standalone_context(ctx);
+	}
+}
+
+QuickJSModulePrefetcher::Graph *QuickJSModulePrefetcher::prefetch(const QuickJSBinder *p_binder, const String &p_file, const List<String> &p_dependencies) {
+	Graph *graph = memnew(Graph);
+	graph->progress = Semaphore::create();
+	graph->use_bytecode_cache = p_binder->is_bytecode_cache_enabled();
+	graph->root = p_file;
+	graph->begin = OS::get_singleton()->get_ticks_usec();
+	graph->seen.insert(p_file);
+	List<String> cached;
+	p_binder->get_cached_modules(&cached);
+	for (const List<String>::Element *E = cached.front(); E; E = E->next()) {
+		graph->cached.insert(E->get());
+	}
+
+	MutexLock lock(mutex);
+	for (const List<String>::Element *E = p_dependencies.front(); E; E = E->next()) {
+		enqueue(graph, E->get());
+	}
+	if (graph->pending == 0) {
+		delete_graph(graph);
+		return NULL;
+	}
+	if (threads.empty()) {
+		exiting = false;
+		const int count = CLAMP(OS::get_singleton()->get_processor_count() - 1, 1, MAX_PREFETCH_THREADS);
+		for (int i = 0; i < count; i++) {
+			threads.push_back(Thread::create(thread_main, NULL));
+		}
+	}
+	return graph;
+}
+
+bool QuickJSModulePrefetcher::take(Graph *p_graph, const String &p_file, Module &r_module) {
+	mutex->lock();
+	while (p_graph->compiling.has(p_file)) {
+		p_graph->waiting_for = p_file;
+		mutex->unlock();
+		p_graph->progress->wait();
+		mutex->lock();
+		p_graph->waiting_for = String();
+	}
+	bool found = false;
+	if (Module *module = p_graph->modules.getptr(p_file)) {
+		r_module = *module;
+		p_graph->modules.erase(p_file);
+		++p_graph->taken;
+		found = true;
+	} else {
+		// Not compiled yet, the caller compiles it now so the threads must not
+		p_graph->seen.insert(p_file);
+		for (List<Task>::Element *E = queue.front(); E; E = E->next()) {
+			if (E->get().graph == p_graph && E->get().file == p_file) {
+				queue.erase(E);
+				--p_graph->pending;
+				break;
+			}
+		}
+	}
+	mutex->unlock();
+	return found;
+}
+
+void QuickJSModulePrefetcher::release(Graph *p_graph) {
+	MutexLock lock(mutex);
+	print_verbose(vformat("ECMAScript: used %d prefetched modules for %s in %.2f ms", p_graph->taken, p_graph->root, (OS::get_singleton()->get_ticks_usec() - p_graph->begin) / 1000.0));
+	List<Task>::Element *E = queue.front();
+	while (E) {
+		List<Task>::Element *next = E->next();
+		if (E->get().graph == p_graph) {
+			queue.erase(E);
+			--p_graph->pending;
+		}
+		E = next;
+	}
+	p_graph->modules.clear();
+	p_graph->released = true;
+	if (p_graph->pending == 0) {
+		delete_graph(p_graph);
+	}
+}
+
+void QuickJSModulePrefetcher::finish() {
+	Vector<Thread *> stopping;
+	{
+		MutexLock lock(mutex);
+		exiting = true;
+		stopping = threads;
+		threads.clear();
+	}
+	for (int i = 0; i < stopping.size(); i++) {
+		semaphore->post();
+	}
+	for (int i = 0; i < stopping.size(); i++) {
+		Thread::wait_to_finish(stopping[i]);
+		memdelete(stopping[i]);
+	}
+}
+
+void QuickJSModulePrefetcher::initialize() {
+	mutex = Mutex::create();
+	semaphore = Semaphore::create();
+}
+
+void QuickJSModulePrefetcher::finalize() {
+	finish();
+	memdelete(semaphore);
+	memdelete(mutex);
+	semaphore = NULL;
+	mutex = NULL;
+}
@@ -0,0 +1,79 @@
+#ifndef QUICKJS_MODULE_PREFETCHER_H
+#define QUICKJS_MODULE_PREFETCHER_H
+
+#include "core/hash_map.h"
+#include "core/list.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/set.h"
+#include "core/ustring.h"
+#include "core/vector.h"
+
+class QuickJSBinder;
+
+// Reads and compiles the static import graph of a module on worker threads before it is linked
+class QuickJSModulePrefetcher {
+public:
+	struct Module {
+		String source;
+		Vector<uint8_t> bytecode;
+	};
+
+	// Import graph compiled in the background for one binder, released once its root module is linked
+	struct Graph {
+		// Posted when the module the owning thread waits for is done
+		Semaphore *progress = NULL;
+		Set<String> seen;
+		// Modules the binder had already cached when the prefetch started
+		Set<String> cached;
+		// Modules a thread is compiling right now
+		Set<String> compiling;
+		String waiting_for;
+		// Queued and compiling modules, the last thread to finish deletes a released graph
+		int pending = 0;
+		int taken = 0;
+		bool use_bytecode_cache = false;
+		bool released = false;
+		HashMap<String, Module> modules;
+		String root;
+		uint64_t begin = 0;
+	};
+
+private:
+	struct Task {
+		Graph *graph;
+		String file;
+	};
+
+	// Threads keep their compiling context between graphs and live until finish()
+	static Mutex *mutex;
+	static Semaphore *semaphore;
+	static List<Task> queue;
+	static Vector<Thread *> threads;
+	static bool exiting;
+
+	static String normalize_specifier(const String &p_base_file, const String &p_specifier);
+	static void enqueue(Graph *p_graph, const String &p_file);
+	static void delete_graph(Graph *p_graph);
+	static void thread_main(void *p_userdata);
+
+public:
+	static bool can_prefetch(const String &p_file);
+	// Resolves import specifiers of a module to the files they load
+	static void resolve_imports(const String &p_file, const List<String> &p_imports, List<String> *r_files);
+	// Starts compiling the given modules and everything they import without waiting, already cached modules are skipped.
+	// Returns NULL when there is nothing to compile
+	static Graph *prefetch(const QuickJSBinder *p_binder, const String &p_file, const List<String> &p_dependencies);
+	// Moves a compiled module out of the graph, waits only if a thread is compiling it right now.
+	// Returns false if the caller should compile the module itself, a queued module is dropped from the graph
+	static bool take(Graph *p_graph, const String &p_file, Module &r_module);
+	// Drops the modules that were not imported, the graph must not be used anymore
+	static void release(Graph *p_graph);
+	static void finish();
+
+	static void initialize();
+	static void finalize();
+};
+
+#endif // QUICKJS_MODULE_PREFETCHER_H
@@ -0,0 +1,149 @@
+#include "quickjs_module_resolver.h"
+#include "../ecmascript.h"
+#include "../ecmascript_language.h"
+#include "core/io/json.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+
+Mutex *QuickJSModuleResolver::mutex = NULL;
+bool QuickJSModuleResolver::index_built = false;
+HashMap<String, bool> QuickJSModuleResolver::res_index;
+HashMap<String, String> QuickJSModuleResolver::resolved;
+
+void QuickJSModuleResolver::index_dir(DirAccess *p_dir, const String &p_path) {
+	if (p_dir->change_dir(p_path) != OK) return;
+	List<String> subdirs;
+	p_dir->list_dir_begin();
+	String name = p_dir->get_next();
+	while (!name.empty()) {
+		if (!name.begins_with(".")) {
+			const String path = p_path.plus_file(name);
+			const bool is_dir = p_dir->current_is_dir();
+			res_index.set(path, is_dir);
+			if (is_dir) {
+				subdirs.push_back(path);
+			}
+		}
+		name = p_dir->get_next();
+	}
+	p_dir->list_dir_end();
+	for (List<String>::Element *E = subdirs.front(); E; E = E->next()) {
+		index_dir(p_dir, E->get());
+	}
+}
+
+void QuickJSModuleResolver::build_index() {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	res_index.clear();
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+	index_dir(da.f, "res://");
+	// Bundled modules have no file of their own
+	const String *path = ResourceFormatLoaderECMAScriptModule::bundle_index.next(NULL);
+	while (path) {
+		res_index.set(*path, false);
+		path = ResourceFormatLoaderECMAScriptModule::bundle_index.next(path);
+	}
+	index_built = true;
+	print_verbose(vformat("ECMAScript: indexed %d module resolution entries in %.2f ms", res_index.size(), (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0));
+}
+
+bool QuickJSModuleResolver::file_exists(const String &p_path) {
+	if (p_path.begins_with("res://")) {
+		const bool *is_dir = res_index.getptr(p_path);
+		return is_dir && !*is_dir;
+	}
+	return FileAccess::exists(p_path);
+}
+
+bool QuickJSModuleResolver::dir_exists(const String &p_path) {
+	if (p_path.begins_with("res://")) {
+		const bool *is_dir = res_index.getptr(p_path);
+		return is_dir && *is_dir;
+	}
+	return DirAccess::exists(p_path);
+}
+
+String QuickJSModuleResolver::resolve_package(const String &p_dir, const List<String> &p_extensions) {
+	const String manifest = p_dir.plus_file("package.json");
+	if (!file_exists(manifest)) return "";
+
+	Variant package;
+	String err_text;
+	int err_line;
+	if (JSON::parse(FileAccess::get_file_as_string(manifest), package, err_text, err_line) != OK || package.get_type() != Variant::DICTIONARY) {
+		ERR_PRINTS(vformat("Invalid package manifest '%s': %s", manifest, err_text));
+		return "";
+	}
+	const Dictionary dict = package;
+	static const char *entry_fields[] = { "module", "main" };
+	for (int i = 0; i < 2; i++) {
+		const Variant entry = dict.get(entry_fields[i], Variant());
+		if (entry.get_type() != Variant::STRING) continue;
+		String path = resolve_path(p_dir.plus_file(entry).simplify_path(), p_extensions, false);
+		if (!path.empty()) return path;
+	}
+	return "";
+}
+
+String QuickJSModuleResolver::resolve_path(const String &p_path, const List<String> &p_extensions, bool p_use_package) {
+	if (file_exists(p_path)) return p_path;
+	// add extensions to try
+	if (p_extensions.find(p_path.get_extension()) == NULL) {
+		for (const List<String>::Element *E = p_extensions.front(); E; E = E->next()) {
+			const String path = p_path + "." + E->get();
+			if (file_exists(path)) return path;
+		}
+	}
+	if (!dir_exists(p_path)) return "";
+	if (p_use_package) {
+		const String path = resolve_package(p_path, p_extensions);
+		if (!path.empty()) return path;
+	}
+	// try index file under the folder
+	for (const List<String>::Element *E = p_extensions.front(); E; E = E->next()) {
+		const String path = p_path + "/index." + E->get();
+		if (file_exists(path)) return path;
+	}
+	return "";
+}
+
+String QuickJSModuleResolver::resolve(const String &p_specifier) {
+	MutexLock lock(mutex);
+	if (const String *path = resolved.getptr(p_specifier)) {
+		return *path;
+	}
+	if (!index_built) {
+		build_index();
+	}
+
+	List<String> extensions;
+	ECMAScriptLanguage::get_singleton()->get_recognized_extensions(&extensions);
+	String path = resolve_path(p_specifier, extensions, true);
+	// Bare specifiers are looked up in the project's node_modules
+	if (path.empty() && !p_specifier.begins_with(".") && p_specifier.find("://") == -1) {
+		path = resolve_path("res://node_modules/" + p_specifier, extensions, true);
+	}
+	resolved.set(p_specifier, path);
+	return path;
+}
+
+void QuickJSModuleResolver::invalidate() {
+	MutexLock lock(mutex);
+	resolved.clear();
+	res_index.clear();
+	index_built = false;
+}
+
+void QuickJSModuleResolver::initialize() {
+	mutex = Mutex::create();
+}
+
+void QuickJSModuleResolver::finalize() {
+	memdelete(mutex);
+	mutex = NULL;
+	resolved.clear();
+	res_index.clear();
+	index_built = false;
+}
@@ -0,0 +1,35 @@
+#ifndef QUICKJS_MODULE_RESOLVER_H
+#define QUICKJS_MODULE_RESOLVER_H
+
+#include "core/hash_map.h"
+#include "core/list.h"
+#include "core/os/mutex.h"
+#include "core/ustring.h"
+
+class DirAccess;
+
+// Resolves import specifiers to module files, caching both hits and misses
+class QuickJSModuleResolver {
+	static Mutex *mutex;
+	static bool index_built;
+	// Every entry under res:// mapped to whether it is a directory
+	static HashMap<String, bool> res_index;
+	// Specifier to resolved file, empty when the specifier could not be resolved
+	static HashMap<String, String> resolved;
+
+	static void build_index();
+	static void index_dir(DirAccess *p_dir, const String &p_path);
+	static bool file_exists(const String &p_path);
+	static bool dir_exists(const String &p_path);
+	static String resolve_path(const String &p_path, const List<String> &p_extensions, bool p_use_package);
+	static String resolve_package(const String &p_dir, const List<String> &p_extensions);
+
+public:
+	static String resolve(const String &p_specifier);
+	static void invalidate();
+
+	static void initialize();
+	static void finalize();
+};
+
+#endif // QUICKJS_MODULE_RESOLVER_H
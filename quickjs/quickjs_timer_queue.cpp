@@ -0,0 +1,82 @@
+#include "quickjs_timer_queue.h"
+
+void QuickJSTimerQueue::push(uint64_t p_time, int64_t p_id) {
+	Entry entry;
+	entry.time = p_time;
+	entry.id = p_id;
+	heap.push_back(entry);
+
+	Entry *w = heap.ptrw();
+	int child = heap.size() - 1;
+	while (child > 0) {
+		const int parent = (child - 1) / 2;
+		if (!is_before(entry, w[parent])) break;
+		w[child] = w[parent];
+		child = parent;
+	}
+	w[child] = entry;
+}
+
+void QuickJSTimerQueue::sift_down(int p_index, const Entry &p_entry) {
+	const int count = heap.size();
+	Entry *w = heap.ptrw();
+	int parent = p_index;
+	while (true) {
+		int child = parent * 2 + 1;
+		if (child >= count) break;
+		if (child + 1 < count && is_before(w[child + 1], w[child])) {
+			child++;
+		}
+		if (!is_before(w[child], p_entry)) break;
+		w[parent] = w[child];
+		parent = child;
+	}
+	w[parent] = p_entry;
+}
+
+void QuickJSTimerQueue::remove_top() {
+	const Entry last = heap[heap.size() - 1];
+	heap.resize(heap.size() - 1);
+	if (!heap.empty()) {
+		sift_down(0, last);
+	}
+}
+
+void QuickJSTimerQueue::drop_cancelled_top() {
+	while (!heap.empty() && cancelled.erase(heap[0].id)) {
+		remove_top();
+	}
+}
+
+void QuickJSTimerQueue::rebuild() {
+	Entry *w = heap.ptrw();
+	int count = 0;
+	for (int i = 0; i < heap.size(); i++) {
+		if (!cancelled.has(w[i].id)) {
+			w[count++] = w[i];
+		}
+	}
+	heap.resize(count);
+	cancelled.clear();
+	for (int i = count / 2 - 1; i >= 0; i--) {
+		const Entry entry = heap[i];
+		sift_down(i, entry);
+	}
+}
+
+bool QuickJSTimerQueue::pop(Entry &r_entry) {
+	if (heap.empty()) return false;
+	r_entry = heap[0];
+	remove_top();
+	drop_cancelled_top();
+	return true;
+}
+
+void QuickJSTimerQueue::cancel(int64_t p_id) {
+	cancelled.set(p_id, true);
+	drop_cancelled_top();
+	// Long lived queues with many cleared timers would otherwise keep growing
+	if (cancelled.size() > heap.size() / 2) {
+		rebuild();
+	}
+}
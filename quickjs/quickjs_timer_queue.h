@@ -0,0 +1,45 @@
+#ifndef QUICKJS_TIMER_QUEUE_H
+#define QUICKJS_TIMER_QUEUE_H
+
+#include "core/hash_map.h"
+#include "core/vector.h"
+
+// Binary min-heap of timer deadlines, the earliest entry is never a cancelled timer
+class QuickJSTimerQueue {
+public:
+	struct Entry {
+		uint64_t time;
+		int64_t id;
+	};
+
+private:
+	Vector<Entry> heap;
+	// Timers cancelled while their entry is still in the heap
+	HashMap<int64_t, bool> cancelled;
+
+	// Timers with the same deadline fire in the order they were created
+	_FORCE_INLINE_ static bool is_before(const Entry &p_a, const Entry &p_b) {
+		return p_a.time < p_b.time || (p_a.time == p_b.time && p_a.id < p_b.id);
+	}
+	void sift_down(int p_index, const Entry &p_entry);
+	void remove_top();
+	void drop_cancelled_top();
+	// Drops every cancelled entry and restores the heap order
+	void rebuild();
+
+public:
+	void push(uint64_t p_time, int64_t p_id);
+	// Removes the earliest entry, fails if the queue is empty
+	bool pop(Entry &r_entry);
+	// The timer must have exactly one entry in the queue
+	void cancel(int64_t p_id);
+	_FORCE_INLINE_ const Entry &top() const { return heap[0]; }
+	_FORCE_INLINE_ bool empty() const { return heap.empty(); }
+	_FORCE_INLINE_ int size() const { return heap.size() - cancelled.size(); }
+	_FORCE_INLINE_ void clear() {
+		heap.clear();
+		cancelled.clear();
+	}
+};
+
+#endif // QUICKJS_TIMER_QUEUE_H
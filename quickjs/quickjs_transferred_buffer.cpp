@@ -0,0 +1,49 @@
+#include "quickjs_transferred_buffer.h"
+#include "core/os/memory.h"
+#include "core/safe_refcount.h"
+
+const JSSharedArrayBufferFunctions QuickJSSharedMemory::functions = {
+	QuickJSSharedMemory::alloc,
+	QuickJSSharedMemory::free,
+	QuickJSSharedMemory::dup,
+	NULL,
+};
+
+void *QuickJSSharedMemory::alloc(void *p_opaque, size_t p_size) {
+	uint8_t *memory = static_cast<uint8_t *>(memalloc(HEADER_SIZE + p_size));
+	ERR_FAIL_NULL_V(memory, NULL);
+	*reinterpret_cast<uint32_t *>(memory) = 1;
+	return memory + HEADER_SIZE;
+}
+
+void QuickJSSharedMemory::free(void *p_opaque, void *p_ptr) {
+	uint8_t *memory = static_cast<uint8_t *>(p_ptr) - HEADER_SIZE;
+	if (atomic_decrement(reinterpret_cast<uint32_t *>(memory)) == 0) {
+		memfree(memory);
+	}
+}
+
+void QuickJSSharedMemory::dup(void *p_opaque, void *p_ptr) {
+	uint8_t *memory = static_cast<uint8_t *>(p_ptr) - HEADER_SIZE;
+	atomic_increment(reinterpret_cast<uint32_t *>(memory));
+}
+
+QuickJSTransferredBuffer::QuickJSTransferredBuffer() {
+	shared_data = NULL;
+	shared_size = 0;
+	owned_data = NULL;
+	owned_size = 0;
+}
+
+QuickJSTransferredBuffer::~QuickJSTransferredBuffer() {
+	if (shared_data) {
+		QuickJSSharedMemory::free(NULL, shared_data);
+	}
+	if (owned_data) {
+		memfree(owned_data);
+	}
+}
+
+void QuickJSTransferredBuffer::free_owned_data(JSRuntime *rt, void *opaque, void *ptr) {
+	memfree(ptr);
+}
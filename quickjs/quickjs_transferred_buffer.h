@@ -0,0 +1,59 @@
+#ifndef QUICKJS_TRANSFERRED_BUFFER_H
+#define QUICKJS_TRANSFERRED_BUFFER_H
+
+#include "core/reference.h"
+#include "quickjs/quickjs.h"
+
+// Reference counted memory of SharedArrayBuffers, any runtime viewing it can release it
+class QuickJSSharedMemory {
+	enum {
+		// Keeps the data aligned for 64 bits atomics
+		HEADER_SIZE = 16,
+	};
+
+public:
+	static const JSSharedArrayBufferFunctions functions;
+
+	static void *alloc(void *p_opaque, size_t p_size);
+	static void free(void *p_opaque, void *p_ptr);
+	static void dup(void *p_opaque, void *p_ptr);
+};
+
+// Bytes of an ArrayBuffer carried by a Worker message, the receiver views them without copying
+class QuickJSTransferredBuffer : public Reference {
+	GDCLASS(QuickJSTransferredBuffer, Reference)
+
+public:
+	// Pool array owning the bytes
+	Variant storage;
+	// Memory taken from a plain ArrayBuffer, owned until the receiver adopts it
+	uint8_t *owned_data;
+	uint32_t owned_size;
+	// Memory of a SharedArrayBuffer, shared instead of copied
+	uint8_t *shared_data;
+	uint32_t shared_size;
+
+	QuickJSTransferredBuffer();
+	~QuickJSTransferredBuffer();
+
+	// Frees the memory of ArrayBuffers adopted from owned_data, every runtime allocates with memalloc
+	static void free_owned_data(JSRuntime *rt, void *opaque, void *ptr);
+};
+
+// TypedArray carried by a Worker message, views sharing an ArrayBuffer share the same buffer
+class QuickJSTransferredView : public Reference {
+	GDCLASS(QuickJSTransferredView, Reference)
+
+public:
+	Ref<QuickJSTransferredBuffer> buffer;
+	String class_name;
+	uint32_t byte_offset;
+	uint32_t length;
+
+	QuickJSTransferredView() {
+		byte_offset = 0;
+		length = 0;
+	}
+};
+
+#endif // QUICKJS_TRANSFERRED_BUFFER_H
@@ -1,58 +1,95 @@
 #include "quickjs_worker.h"
+#include "../ecmascript_language.h"
+#include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "quickjs_worker_pool.h"
 
-void QuickJSWorker::thread_main(void *p_this) {
-	QuickJSWorker *self = static_cast<QuickJSWorker *>(p_this);
+void QuickJSWorker::bind_thread() {
+	thread_id = Thread::get_caller_id();
+	ECMAScriptLanguage::set_pooled_thread_binder(this);
+}
 
-	self->initialize();
-	self->running = true;
+void QuickJSWorker::unbind_thread() {
+	if (ECMAScriptLanguage::get_pooled_thread_binder() == this) {
+		ECMAScriptLanguage::set_pooled_thread_binder(NULL);
+	}
+}
+
+void QuickJSWorker::bind_to_current_thread() {
+	JS_UpdateStackTop(runtime);
+	bind_thread();
+}
 
-	Error err;
-	String text = FileAccess::get_file_as_string(self->entry_script, &err);
+// Runs the worker until it has no more work, returns false once it has shut down
+bool QuickJSWorker::run_slice() {
+	if (!initialized) {
+		if (!running) return false;
+		initialize();
+		initialized = true;
 
-	if (err == OK) {
-		String err_text;
-		ECMAScriptGCHandler eval_ret;
-		err = self->safe_eval_text(text, ECMAScriptBinder::EVAL_TYPE_MODULE, self->entry_script, err_text, eval_ret);
+		Error err;
+		String text = FileAccess::get_file_as_string(entry_script, &err);
 		if (err == OK) {
-			JSValue onmessage_callback = JS_GetPropertyStr(self->ctx, self->global_object, "onmessage");
-			bool onmessage_valid = JS_IsFunction(self->ctx, onmessage_callback);
-			while (self->running) {
-				self->frame();
-
-				if (onmessage_valid) {
-					List<Variant> messages;
-					{
-						GLOBAL_LOCK_FUNCTION
-						for (List<Variant>::Element *E = self->input_message_queue.front(); E; E = E->next()) {
-							messages.push_back(E->get());
-						}
-						self->input_message_queue.clear();
-					}
-					for (List<Variant>::Element *E = messages.front(); E; E = E->next()) {
-						JSValue argv[] = { variant_to_var(self->ctx, E->get()) };
-						JSValue ret = JS_Call(self->ctx, onmessage_callback, self->global_object, 1, argv);
-						if (JS_IsException(ret)) {
-							JSValue e = JS_GetException(self->ctx);
-							ECMAscriptScriptError err;
-							dump_exception(self->ctx, e, &err);
-							ERR_PRINTS(String("Error in worker onmessage callback") + ENDL + self->error_to_string(err));
-							JS_FreeValue(self->ctx, e);
-						}
-						JS_FreeValue(self->ctx, argv[0]);
-					}
-				}
-				OS::get_singleton()->delay_usec(1000);
+			String err_text;
+			ECMAScriptGCHandler eval_ret;
+			err = safe_eval_text(text, ECMAScriptBinder::EVAL_TYPE_MODULE, entry_script, err_text, eval_ret);
+			if (err != OK) {
+				ERR_PRINTS("Failed to eval entry script:" + entry_script + "\nError:" + err_text);
 			}
-			JS_FreeValue(self->ctx, onmessage_callback);
 		} else {
-			ERR_PRINTS("Failed to eval entry script:" + self->entry_script + "\nError:" + err_text);
+			ERR_PRINTS("Failed to load entry script:" + entry_script);
+		}
+		onmessage_callback = JS_GetPropertyStr(ctx, global_object, "onmessage");
+		if (err != OK) {
+			running = false;
 		}
+	} else if (running) {
+		bind_to_current_thread();
 	} else {
-		ERR_PRINTS("Failed to load entry script:" + self->entry_script);
+		// Shutting down from the thread that stops the worker, keep its own thread binding
+		JS_UpdateStackTop(runtime);
 	}
 
-	self->uninitialize();
+	if (running) {
+		if (JS_IsFunction(ctx, onmessage_callback)) {
+			Vector<Variant> messages;
+			input_message_queue.pop_all(messages);
+			for (int i = 0; i < messages.size(); i++) {
+				JSValue argv[] = { variant_to_var(ctx, messages[i]) };
+				JSValue ret = JS_Call(ctx, onmessage_callback, global_object, 1, argv);
+				if (JS_IsException(ret)) {
+					JSValue e = JS_GetException(ctx);
+					ECMAscriptScriptError err;
+					dump_exception(ctx, e, &err);
+					ERR_PRINTS(String("Error in worker onmessage callback") + ENDL + error_to_string(err));
+					JS_FreeValue(ctx, e);
+				}
+				JS_FreeValue(ctx, argv[0]);
+			}
+		} else {
+			input_message_queue.discard_all();
+		}
+		frame();
+		animating = !frame_callbacks.empty() || !workers.empty();
+		// Jobs left for later keep the worker queued, an idle worker stays parked until something wakes it
+		if (JS_IsJobPending(runtime)) {
+			QuickJSWorkerPool::schedule(this);
+		}
+	}
+
+	if (!running) {
+		JS_FreeValue(ctx, onmessage_callback);
+		uninitialize();
+		return false;
+	}
+	// The pool thread may run another worker next
+	unbind_thread();
+	return true;
+}
+
+// Aborts the running script once the host terminates the worker
+int QuickJSWorker::interrupt_handler(JSRuntime *rt, void *opaque) {
+	return static_cast<QuickJSWorker *>(opaque)->terminating ? 1 : 0;
 }
 
 JSValue QuickJSWorker::global_worker_close(JSContext *ctx, JSValue this_val, int argc, JSValue *argv) {
@@ -67,10 +104,13 @@ JSValue QuickJSWorker::global_worker_post_message(JSContext *ctx, JSValue this_v
 	ERR_FAIL_COND_V(argc < 1, JS_ThrowTypeError(ctx, "message value expected of argument #0"));
 	QuickJSWorker *worker = static_cast<QuickJSWorker *>(get_context_binder(ctx));
 	if (worker) {
-		GLOBAL_LOCK_FUNCTION
-		worker->output_message_queue.push_back(var_to_variant(ctx, argv[0]));
+		Variant message;
+		if (!js_to_message(ctx, argv[0], argc > 1 ? argv[1] : JS_UNDEFINED, message)) {
+			return JS_EXCEPTION;
+		}
+		return JS_NewBool(ctx, worker->post_message(worker->output_message_queue, message, worker->host_context, worker->block_on_full_queue));
 	}
-	return JS_UNDEFINED;
+	return JS_FALSE;
 }
 
 JSValue QuickJSWorker::global_import_scripts(JSContext *ctx, JSValue this_val, int argc, JSValue *argv) {
@@ -87,19 +127,25 @@ JSValue QuickJSWorker::global_import_scripts(JSContext *ctx, JSValue this_val, i
 	return JS_UNDEFINED;
 }
 
-QuickJSWorker::QuickJSWorker(const QuickJSBinder *p_host_context) :
+QuickJSWorker::QuickJSWorker(QuickJSBinder *p_host_context) :
 		QuickJSBinder() {
-	thread = NULL;
 	running = false;
+	terminating = false;
+	onmessage_callback = JS_UNDEFINED;
 	host_context = p_host_context;
+	block_on_full_queue = true;
+	finished = Semaphore::create();
 }
 
 QuickJSWorker::~QuickJSWorker() {
 	stop();
+	memdelete(finished);
 }
 
 void QuickJSWorker::initialize() {
 	QuickJSBinder::initialize();
+	// Atomics.wait would keep a pool thread blocked, so it stays disabled like on the main thread
+	JS_SetInterruptHandler(runtime, interrupt_handler, this);
 	// onmessage
 	JS_SetPropertyStr(ctx, global_object, "onmessage", JS_NULL);
 	// close
@@ -118,22 +164,19 @@ void QuickJSWorker::uninitialize() {
 	QuickJSBinder::uninitialize();
 }
 
+void QuickJSWorker::wake_up() {
+	QuickJSWorkerPool::schedule(this);
+}
+
 bool QuickJSWorker::frame_of_host(QuickJSBinder *host, const JSValueConst &value) {
 
 	JSValue onmessage_callback = JS_GetPropertyStr(host->ctx, value, "onmessage");
 	if (JS_IsFunction(host->ctx, onmessage_callback)) {
 
-		List<Variant> messages;
-		{
-			GLOBAL_LOCK_FUNCTION
-			for (List<Variant>::Element *E = output_message_queue.front(); E; E = E->next()) {
-				messages.push_back(E->get());
-			}
-			output_message_queue.clear();
-		}
-
-		for (List<Variant>::Element *E = messages.front(); E; E = E->next()) {
-			JSValue argv[] = { variant_to_var(host->ctx, E->get()) };
+		Vector<Variant> messages;
+		output_message_queue.pop_all(messages);
+		for (int i = 0; i < messages.size(); i++) {
+			JSValue argv[] = { variant_to_var(host->ctx, messages[i]) };
 			JSValue ret = JS_Call(host->ctx, onmessage_callback, JS_NULL, 1, argv);
 			if (JS_IsException(ret)) {
 				JSValue e = JS_GetException(host->ctx);
@@ -144,28 +187,63 @@ bool QuickJSWorker::frame_of_host(QuickJSBinder *host, const JSValueConst &value
 			}
 			JS_FreeValue(host->ctx, argv[0]);
 		}
+	} else {
+		output_message_queue.discard_all();
 	}
 
 	JS_FreeValue(host->ctx, onmessage_callback);
+	if (animating) {
+		wake_up();
+	}
 	return running;
 }
 
-void QuickJSWorker::post_message_from_host(const Variant &p_message) {
-	GLOBAL_LOCK_FUNCTION
-	input_message_queue.push_back(p_message);
+// Returns false when the message is dropped because the queue stayed full
+bool QuickJSWorker::post_message(QuickJSMessageQueue &p_queue, const Variant &p_message, QuickJSBinder *p_consumer, bool p_can_block) {
+	if (!p_queue.try_push(p_message)) {
+		if (!p_can_block) {
+			p_queue.record_dropped();
+			return false;
+		}
+		p_queue.record_blocked();
+		p_consumer->wake_up();
+		// Parked until the consumer's pop_all makes room
+		if (!p_queue.push_wait(p_message, MESSAGE_BLOCK_TIMEOUT_USEC)) {
+			p_queue.record_dropped();
+			return false;
+		}
+	}
+	p_consumer->wake_up();
+	return true;
+}
+
+void QuickJSWorker::setup_message_queues(int p_capacity, bool p_block_on_full) {
+	input_message_queue.setup(p_capacity);
+	output_message_queue.setup(p_capacity);
+	block_on_full_queue = p_block_on_full;
+}
+
+bool QuickJSWorker::post_message_from_host(const Variant &p_message) {
+	// The host is the main thread or a pool thread other workers need, it never waits for room
+	return post_message(input_message_queue, p_message, this, false);
+}
+
+Dictionary QuickJSWorker::get_message_stats() {
+	Dictionary stats;
+	stats["input"] = input_message_queue.get_stats();
+	stats["output"] = output_message_queue.get_stats();
+	stats["scheduler"] = QuickJSWorkerPool::get_stats(this);
+	return stats;
 }
 
 void QuickJSWorker::start(const String &p_path) {
-	ERR_FAIL_COND(running || thread != NULL);
+	ERR_FAIL_COND(running || initialized);
+	ERR_FAIL_COND_MSG(input_message_queue.get_capacity() == 0, "Message queues must be set up before starting the worker.");
 	entry_script = p_path;
-	thread = Thread::create(thread_main, this);
+	running = true;
+	QuickJSWorkerPool::add(this);
 }
 
 void QuickJSWorker::stop() {
-	if (thread != NULL) {
-		running = false;
-		Thread::wait_to_finish(thread);
-		memdelete(thread);
-		thread = NULL;
-	}
+	QuickJSWorkerPool::remove(this);
 }
@@ -1,32 +1,76 @@
 #ifndef QUICKJS_WORKER_H
 #define QUICKJS_WORKER_H
 
-#include "core/os/thread.h"
+#include "core/os/semaphore.h"
 #include "quickjs_binder.h"
+#include "quickjs_message_queue.h"
+
+// How long a full queue may block postMessage before the message is dropped
+#define MESSAGE_BLOCK_TIMEOUT_USEC 100000
 
 class QuickJSWorker : public QuickJSBinder {
-	Thread *thread;
+	friend class QuickJSWorkerPool;
+
+	enum PoolState {
+		POOL_NONE,
+		POOL_QUEUED,
+		POOL_RUNNING,
+		POOL_PARKED,
+		POOL_FINISHED,
+	};
+	// Scheduling state, guarded by the pool mutex
+	PoolState pool_state = POOL_NONE;
+	int pool_runner = -1;
+	bool pool_wake_pending = false;
+	Semaphore *finished;
+	// Wake up latency, from being queued to running on a pool thread
+	uint64_t pool_queued_time = 0;
+	uint64_t pool_wakeups = 0;
+	uint64_t pool_total_latency = 0;
+	uint64_t pool_max_latency = 0;
+	// Deadline of the earliest timer when the worker parked
+	uint64_t pool_timer_time = 0;
+
 	bool running = false;
-	static void thread_main(void *p_self);
+	// Set by the host on terminate, read by the interrupt handler on the pool thread
+	volatile bool terminating;
+	bool initialized = false;
+	// Parked workers with animation frame callbacks or child workers are woken every host frame
+	bool animating = false;
 	String entry_script;
+	JSValue onmessage_callback;
+
+	QuickJSBinder *host_context;
+	// Host to worker, and worker to host
+	QuickJSMessageQueue input_message_queue;
+	QuickJSMessageQueue output_message_queue;
+	// Only applies to messages the worker posts to its host
+	bool block_on_full_queue;
 
-	const QuickJSBinder *host_context;
-	List<Variant> input_message_queue;
-	List<Variant> output_message_queue;
+	bool run_slice();
+	virtual void bind_thread();
+	virtual void unbind_thread();
+	bool post_message(QuickJSMessageQueue &p_queue, const Variant &p_message, QuickJSBinder *p_consumer, bool p_can_block);
+	void bind_to_current_thread();
 
+	static int interrupt_handler(JSRuntime *rt, void *opaque);
 	static JSValue global_worker_close(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 	static JSValue global_worker_post_message(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 	static JSValue global_import_scripts(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 
 public:
-	QuickJSWorker(const QuickJSBinder *p_host_context);
+	QuickJSWorker(QuickJSBinder *p_host_context);
 	virtual ~QuickJSWorker();
 
 	virtual void initialize();
 	virtual void uninitialize();
+	virtual void wake_up();
 
 	bool frame_of_host(QuickJSBinder *host, const JSValueConst &value);
-	void post_message_from_host(const Variant &p_message);
+	// Must be called before start
+	void setup_message_queues(int p_capacity, bool p_block_on_full);
+	bool post_message_from_host(const Variant &p_message);
+	Dictionary get_message_stats();
 	void start(const String &p_path);
 	void stop();
 };
@@ -0,0 +1,266 @@
+#include "quickjs_worker_pool.h"
+#include "core/os/os.h"
+#include "core/project_settings.h"
+#include "quickjs_worker.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Counting semaphore with a timed wait, which Semaphore lacks, so parked timers wake their worker on time
+static std::mutex signal_mutex;
+static std::condition_variable signal_condition;
+static uint32_t signal_count = 0;
+
+Mutex *QuickJSWorkerPool::mutex = NULL;
+Mutex *QuickJSWorkerPool::lifecycle_mutex = NULL;
+Vector<QuickJSWorkerPool::Runner *> QuickJSWorkerPool::runners;
+List<QuickJSWorker *> QuickJSWorkerPool::workers;
+int QuickJSWorkerPool::worker_count = 0;
+int QuickJSWorkerPool::next_runner = 0;
+bool QuickJSWorkerPool::exiting = false;
+
+int QuickJSWorkerPool::get_thread_count() {
+	int count = GLOBAL_DEF("JavaScript/worker/thread_pool_size", 0);
+	if (count <= 0) {
+		// Leave a core to the main thread
+		count = OS::get_singleton()->get_processor_count() - 1;
+	}
+	return MAX(count, 1);
+}
+
+void QuickJSWorkerPool::start_threads() {
+	exiting = false;
+	const int count = get_thread_count();
+	for (int i = 0; i < count; i++) {
+		Runner *runner = memnew(Runner);
+		runner->index = i;
+		runners.push_back(runner);
+	}
+	for (int i = 0; i < count; i++) {
+		runners[i]->thread = Thread::create(thread_main, runners[i]);
+	}
+}
+
+void QuickJSWorkerPool::stop_threads() {
+	{
+		MutexLock lock(mutex);
+		exiting = true;
+	}
+	for (int i = 0; i < runners.size(); i++) {
+		signal();
+	}
+	for (int i = 0; i < runners.size(); i++) {
+		Thread::wait_to_finish(runners[i]->thread);
+		memdelete(runners[i]->thread);
+		memdelete(runners[i]);
+	}
+	runners.clear();
+}
+
+QuickJSWorker *QuickJSWorkerPool::take(Runner *p_runner) {
+	if (!p_runner->queue.empty()) {
+		QuickJSWorker *worker = p_runner->queue.front()->get();
+		p_runner->queue.pop_front();
+		return worker;
+	}
+	for (int i = 1; i < runners.size(); i++) {
+		Runner *victim = runners[(p_runner->index + i) % runners.size()];
+		if (!victim->queue.empty()) {
+			QuickJSWorker *worker = victim->queue.back()->get();
+			victim->queue.pop_back();
+			return worker;
+		}
+	}
+	return NULL;
+}
+
+void QuickJSWorkerPool::enqueue(QuickJSWorker *p_worker) {
+	if (p_worker->pool_runner < 0) {
+		p_worker->pool_runner = next_runner++ % runners.size();
+	}
+	p_worker->pool_state = QuickJSWorker::POOL_QUEUED;
+	p_worker->pool_queued_time = OS::get_singleton()->get_ticks_usec();
+	p_worker->pool_wakeups++;
+	runners[p_worker->pool_runner]->queue.push_back(p_worker);
+	signal();
+}
+
+uint64_t QuickJSWorkerPool::get_timer_deadline() {
+	uint64_t deadline = 0;
+	for (List<QuickJSWorker *>::Element *E = workers.front(); E; E = E->next()) {
+		const QuickJSWorker *worker = E->get();
+		if (worker->pool_state == QuickJSWorker::POOL_PARKED && worker->pool_timer_time && (deadline == 0 || worker->pool_timer_time < deadline)) {
+			deadline = worker->pool_timer_time;
+		}
+	}
+	return deadline;
+}
+
+void QuickJSWorkerPool::wake_timers(uint64_t p_now) {
+	for (List<QuickJSWorker *>::Element *E = workers.front(); E; E = E->next()) {
+		QuickJSWorker *worker = E->get();
+		if (worker->pool_state == QuickJSWorker::POOL_PARKED && worker->pool_timer_time && worker->pool_timer_time <= p_now) {
+			enqueue(worker);
+		}
+	}
+}
+
+void QuickJSWorkerPool::signal() {
+	{
+		std::lock_guard<std::mutex> lock(signal_mutex);
+		signal_count++;
+	}
+	signal_condition.notify_one();
+}
+
+void QuickJSWorkerPool::wait_signal(uint64_t p_deadline) {
+	std::unique_lock<std::mutex> lock(signal_mutex);
+	if (p_deadline == 0) {
+		signal_condition.wait(lock, [] { return signal_count > 0; });
+	} else {
+		const uint64_t now = OS::get_singleton()->get_ticks_usec();
+		if (p_deadline > now) {
+			signal_condition.wait_for(lock, std::chrono::microseconds(p_deadline - now), [] { return signal_count > 0; });
+		}
+	}
+	if (signal_count > 0) {
+		signal_count--;
+	}
+}
+
+void QuickJSWorkerPool::thread_main(void *p_runner) {
+	Runner *runner = static_cast<Runner *>(p_runner);
+	while (true) {
+		uint64_t deadline = 0;
+		{
+			MutexLock lock(mutex);
+			deadline = get_timer_deadline();
+		}
+		wait_signal(deadline);
+		QuickJSWorker *worker = NULL;
+		{
+			MutexLock lock(mutex);
+			if (exiting) break;
+			wake_timers(OS::get_singleton()->get_ticks_usec());
+			worker = take(runner);
+			if (worker == NULL) continue;
+			worker->pool_state = QuickJSWorker::POOL_RUNNING;
+			worker->pool_runner = runner->index;
+			const uint64_t latency = OS::get_singleton()->get_ticks_usec() - worker->pool_queued_time;
+			worker->pool_total_latency += latency;
+			worker->pool_max_latency = MAX(worker->pool_max_latency, latency);
+		}
+
+		const bool alive = worker->run_slice();
+
+		MutexLock lock(mutex);
+		worker->pool_timer_time = alive ? worker->get_next_timer_time() : 0;
+		if (!alive) {
+			worker->pool_state = QuickJSWorker::POOL_FINISHED;
+			worker->finished->post();
+		} else if (worker->pool_wake_pending) {
+			worker->pool_wake_pending = false;
+			enqueue(worker);
+		} else {
+			worker->pool_state = QuickJSWorker::POOL_PARKED;
+		}
+	}
+}
+
+void QuickJSWorkerPool::add(QuickJSWorker *p_worker) {
+	MutexLock lifecycle(lifecycle_mutex);
+	MutexLock lock(mutex);
+	if (worker_count++ == 0) {
+		start_threads();
+	}
+	p_worker->pool_runner = -1;
+	p_worker->pool_wake_pending = false;
+	p_worker->pool_timer_time = 0;
+	workers.push_back(p_worker);
+	enqueue(p_worker);
+}
+
+void QuickJSWorkerPool::remove(QuickJSWorker *p_worker) {
+	bool run_here = false;
+	bool wait_finish = false;
+	{
+		MutexLock lock(mutex);
+		p_worker->running = false;
+		p_worker->terminating = true;
+		switch (p_worker->pool_state) {
+			case QuickJSWorker::POOL_NONE:
+				return;
+			case QuickJSWorker::POOL_RUNNING:
+				// Run once more to shut down if the current slice already checked the flag
+				p_worker->pool_wake_pending = true;
+				wait_finish = true;
+				break;
+			case QuickJSWorker::POOL_QUEUED:
+				runners[p_worker->pool_runner]->queue.erase(p_worker);
+				run_here = true;
+				break;
+			case QuickJSWorker::POOL_PARKED:
+				run_here = true;
+				break;
+			case QuickJSWorker::POOL_FINISHED:
+				break;
+		}
+		if (run_here) {
+			p_worker->pool_state = QuickJSWorker::POOL_RUNNING;
+		}
+	}
+
+	if (run_here) {
+		p_worker->run_slice();
+	} else if (wait_finish) {
+		p_worker->finished->wait();
+	}
+
+	// No slice can be running once the last worker is gone, so the threads can be joined
+	MutexLock lifecycle(lifecycle_mutex);
+	bool last = false;
+	{
+		MutexLock lock(mutex);
+		p_worker->pool_state = QuickJSWorker::POOL_NONE;
+		workers.erase(p_worker);
+		last = --worker_count == 0;
+	}
+	if (last) {
+		stop_threads();
+	}
+}
+
+void QuickJSWorkerPool::schedule(QuickJSWorker *p_worker) {
+	MutexLock lock(mutex);
+	switch (p_worker->pool_state) {
+		case QuickJSWorker::POOL_PARKED:
+			enqueue(p_worker);
+			break;
+		case QuickJSWorker::POOL_RUNNING:
+			p_worker->pool_wake_pending = true;
+			break;
+		default:
+			break;
+	}
+}
+
+Dictionary QuickJSWorkerPool::get_stats(QuickJSWorker *p_worker) {
+	MutexLock lock(mutex);
+	Dictionary stats;
+	stats["wakeups"] = p_worker->pool_wakeups;
+	stats["latency_avg_usec"] = p_worker->pool_wakeups ? p_worker->pool_total_latency / p_worker->pool_wakeups : 0;
+	stats["latency_max_usec"] = p_worker->pool_max_latency;
+	return stats;
+}
+
+void QuickJSWorkerPool::initialize() {
+	mutex = Mutex::create();
+	lifecycle_mutex = Mutex::create();
+}
+
+void QuickJSWorkerPool::finalize() {
+	memdelete(lifecycle_mutex);
+	memdelete(mutex);
+	lifecycle_mutex = NULL;
+	mutex = NULL;
+}
@@ -0,0 +1,56 @@
+#ifndef QUICKJS_WORKER_POOL_H
+#define QUICKJS_WORKER_POOL_H
+
+#include "core/dictionary.h"
+#include "core/list.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/vector.h"
+
+class QuickJSWorker;
+
+// Runs every Worker on a fixed set of threads, a worker is only queued while it has work to do
+class QuickJSWorkerPool {
+	struct Runner {
+		int index;
+		Thread *thread;
+		// Workers that last ran on this thread, idle runners steal from the others
+		List<QuickJSWorker *> queue;
+	};
+
+	static Mutex *mutex;
+	// Serializes starting and stopping the threads
+	static Mutex *lifecycle_mutex;
+	static Vector<Runner *> runners;
+	// Every added worker, parked ones are scanned for due timers
+	static List<QuickJSWorker *> workers;
+	static int worker_count;
+	static int next_runner;
+	static bool exiting;
+
+	static int get_thread_count();
+	static void start_threads();
+	static void stop_threads();
+	static void thread_main(void *p_runner);
+	static QuickJSWorker *take(Runner *p_runner);
+	static void enqueue(QuickJSWorker *p_worker);
+	// Earliest timer of the parked workers, 0 when none is pending
+	static uint64_t get_timer_deadline();
+	static void wake_timers(uint64_t p_now);
+	// Wakes one thread, the wait also ends at the given deadline
+	static void signal();
+	static void wait_signal(uint64_t p_deadline);
+
+public:
+	static void add(QuickJSWorker *p_worker);
+	// Waits for the worker to finish, it is never touched by the pool afterwards
+	static void remove(QuickJSWorker *p_worker);
+	// Wakes a parked worker, a worker woken while it runs is queued again after its slice
+	static void schedule(QuickJSWorker *p_worker);
+	static Dictionary get_stats(QuickJSWorker *p_worker);
+
+	static void initialize();
+	static void finalize();
+};
+
+#endif // QUICKJS_WORKER_POOL_H
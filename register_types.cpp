@@ -31,11 +31,17 @@
 #include "register_types.h"
 #include "ecmascript.h"
 #include "ecmascript_language.h"
+#include "quickjs/quickjs_transferred_buffer.h"
 
 #ifdef TOOLS_ENABLED
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+#include "core/safe_refcount.h"
 #include "editor/editor_export.h"
+#include "editor/editor_file_system.h"
 #include "editor/editor_node.h"
+#include "quickjs/quickjs_bytecode_cache.h"
 #include "tools/editor_tools.h"
 void editor_init_callback();
 
@@ -43,7 +49,195 @@ class EditorExportECMAScript : public EditorExportPlugin {
 
 	GDCLASS(EditorExportECMAScript, EditorExportPlugin);
 
+	struct CompileJob {
+		String path;
+		Vector<uint8_t> bytecode;
+		ECMAscriptScriptError error;
+		Error err = OK;
+		bool cached = false;
+		uint64_t usec = 0;
+	};
+
+	struct CompileBatch {
+		CompileJob *jobs = NULL;
+		uint32_t job_count = 0;
+		uint32_t next_job = 0;
+	};
+
+	Map<String, Vector<uint8_t> > compiled_bytecode;
+	bool compiled = false;
+	bool bundled = false;
+
+	static void collect_script_files(EditorFileSystemDirectory *p_dir, List<String> &r_files) {
+		for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+			collect_script_files(p_dir->get_subdir(i), r_files);
+		}
+		for (int i = 0; i < p_dir->get_file_count(); i++) {
+			String extension = p_dir->get_file(i).get_extension();
+			if (extension == EXT_JSCLASS || extension == EXT_JSMODULE) {
+				r_files.push_back(p_dir->get_file_path(i));
+			}
+		}
+	}
+
+	static Vector<String> split_filter(const String &p_filter) {
+		Vector<String> filters;
+		Vector<String> split = p_filter.split(",");
+		for (int i = 0; i < split.size(); i++) {
+			const String filter = split[i].strip_edges();
+			if (!filter.empty()) {
+				filters.push_back(filter);
+			}
+		}
+		return filters;
+	}
+
+	static bool matches_filter(const String &p_path, const Vector<String> &p_filters) {
+		const String relative = p_path.replace_first("res://", "");
+		for (int i = 0; i < p_filters.size(); i++) {
+			if (p_path.matchn(p_filters[i]) || relative.matchn(p_filters[i])) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static void find_dependencies(const String &p_path, Set<String> &r_paths) {
+		if (r_paths.has(p_path))
+			return;
+		r_paths.insert(p_path);
+		int file_index = 0;
+		EditorFileSystemDirectory *dir = EditorFileSystem::get_singleton()->find_file(p_path, &file_index);
+		if (!dir)
+			return;
+		Vector<String> dependencies = dir->get_file_deps(file_index);
+		for (int i = 0; i < dependencies.size(); i++) {
+			find_dependencies(dependencies[i], r_paths);
+		}
+	}
+
+	// Picks script files the way the exporter picks the files of a preset
+	static void collect_exported_script_files(const Ref<EditorExportPreset> &p_preset, List<String> &r_files) {
+		List<String> files;
+		collect_script_files(EditorFileSystem::get_singleton()->get_filesystem(), files);
+		if (p_preset.is_null()) {
+			r_files = files;
+			return;
+		}
+
+		const bool export_all = p_preset->get_export_filter() == EditorExportPreset::EXPORT_ALL_RESOURCES;
+		Set<String> selected;
+		if (!export_all) {
+			Vector<String> selected_files = p_preset->get_files_to_export();
+			for (int i = 0; i < selected_files.size(); i++) {
+				find_dependencies(selected_files[i], selected);
+			}
+		}
+		const Vector<String> include = split_filter(p_preset->get_include_filter());
+		const Vector<String> exclude = split_filter(p_preset->get_exclude_filter());
+		for (List<String>::Element *E = files.front(); E; E = E->next()) {
+			const String &path = E->get();
+			if ((export_all || selected.has(path) || matches_filter(path, include)) && !matches_filter(path, exclude)) {
+				r_files.push_back(path);
+			}
+		}
+	}
+
+	// Each thread compiles in its own runtime and takes jobs until the batch is drained
+	static void compile_thread(void *p_batch) {
+		CompileBatch *batch = static_cast<CompileBatch *>(p_batch);
+		JSContext *ctx = NULL;
+		while (true) {
+			uint32_t index = atomic_increment(&batch->next_job) - 1;
+			if (index >= batch->job_count) break;
+			CompileJob &job = batch->jobs[index];
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			String code = FileAccess::get_file_as_string(job.path, &job.err);
+			if (job.err == OK) {
+				if (QuickJSBytecodeCache::load(job.path, code, job.bytecode) == OK) {
+					job.cached = true;
+				} else {
+					if (!ctx) ctx = QuickJSBinder::new_standalone_context();
+					job.err = QuickJSBinder::compile_module_standalone(ctx, code, job.path, job.bytecode, &job.error);
+					if (job.err == OK) {
+						QuickJSBytecodeCache::save(job.path, code, job.bytecode.ptr(), job.bytecode.size());
+					}
+				}
+			}
+			job.usec = OS::get_singleton()->get_ticks_usec() - begin;
+		}
+		if (ctx) {
+			QuickJSBinder::free_standalone_context(ctx);
+		}
+	}
+
+	// Prefixes bytecode with the header that lets the runtime skip hashing it on load
+	static Vector<uint8_t> make_bytecode_file(const Vector<uint8_t> &p_bytecode) {
+		Vector<uint8_t> file;
+		file.resize(ECMASCRIPT_BYTECODE_HEADER_SIZE + p_bytecode.size());
+		encode_uint32(ECMASCRIPT_BYTECODE_MAGIC, file.ptrw());
+		encode_uint32(hash_djb2_buffer(p_bytecode.ptr(), p_bytecode.size()), file.ptrw() + 4);
+		copymem(file.ptrw() + ECMASCRIPT_BYTECODE_HEADER_SIZE, p_bytecode.ptr(), p_bytecode.size());
+		return file;
+	}
+
+	// Export presets are only assigned after _export_begin, so the pre-pass runs with the first script file
+	void compile_all_scripts() {
+		compiled = true;
+		List<String> files;
+		collect_exported_script_files(get_export_preset(), files);
+		if (files.empty())
+			return;
+
+		Vector<CompileJob> jobs;
+		jobs.resize(files.size());
+		int index = 0;
+		for (List<String>::Element *E = files.front(); E; E = E->next()) {
+			jobs.write[index++].path = E->get();
+		}
+
+		CompileBatch batch;
+		batch.jobs = jobs.ptrw();
+		batch.job_count = jobs.size();
+		const int thread_count = CLAMP(OS::get_singleton()->get_processor_count(), 1, jobs.size());
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		Vector<Thread *> threads;
+		for (int i = 0; i < thread_count; i++) {
+			threads.push_back(Thread::create(compile_thread, &batch));
+		}
+		for (int i = 0; i < threads.size(); i++) {
+			Thread::wait_to_finish(threads[i]);
+			memdelete(threads[i]);
+		}
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		int cached_count = 0;
+		ECMAScriptBinder *binder = ECMAScriptLanguage::get_singleton()->get_main_binder();
+		for (int i = 0; i < jobs.size(); i++) {
+			const CompileJob &job = jobs[i];
+			if (job.err != OK) {
+				ERR_PRINTS(vformat("Failed to compile %s\n%s", job.path, binder->error_to_string(job.error)));
+				continue;
+			}
+			cached_count += job.cached ? 1 : 0;
+			compiled_bytecode.insert(job.path, job.bytecode);
+			print_verbose(vformat("ECMAScript: %s %s in %.2f ms", job.cached ? "loaded cached" : "compiled", job.path, job.usec / 1000.0));
+		}
+		print_line(vformat("ECMAScript: compiled %d modules (%d cached) in %.2f ms with %d threads", jobs.size(), cached_count, elapsed / 1000.0, thread_count));
+	}
+
 public:
+	virtual void _export_begin(const Set<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+		compiled = false;
+		bundled = false;
+		compiled_bytecode.clear();
+	}
+
+	virtual void _export_end() {
+		compiled_bytecode.clear();
+	}
+
 	virtual void _export_file(const String &p_path, const String &p_type, const Set<String> &p_features) {
 		int script_mode = EditorExportPreset::MODE_SCRIPT_COMPILED;
 		const Ref<EditorExportPreset> &preset = get_export_preset();
@@ -58,6 +252,25 @@ public:
 		if (extension != EXT_JSCLASS && extension != EXT_JSMODULE)
 			return;
 
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_COMPILED && !compiled) {
+			compile_all_scripts();
+		}
+
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_COMPILED && GLOBAL_GET("JavaScript/export/bundle_modules")) {
+			// Extra files are only packed when added from _export_file, so the bundle goes out with the first script.
+			// It holds the scripts the preset exports, any other script is exported as a file of its own
+			if (!bundled) {
+				bundled = true;
+				Vector<uint8_t> bundle;
+				ResourceFormatLoaderECMAScriptModule::write_bundle(compiled_bytecode, bundle);
+				add_file(ECMASCRIPT_BUNDLE_PATH, bundle, false);
+			}
+			if (compiled_bytecode.has(p_path)) {
+				skip();
+				return;
+			}
+		}
+
 		if (script_mode == EditorExportPreset::MODE_SCRIPT_ENCRYPTED) {
 			Vector<uint8_t> file = FileAccess::get_file_as_array(p_path);
 			if (file.empty())
@@ -107,13 +320,18 @@ public:
 
 		} else {
 
+			if (const Map<String, Vector<uint8_t> >::Element *E = compiled_bytecode.find(p_path)) {
+				add_file(p_path.get_basename() + "." + extension + "b", make_bytecode_file(E->get()), true);
+				return;
+			}
+
 			Error err;
 			String code = FileAccess::get_file_as_string(p_path, &err);
 			ERR_FAIL_COND(err != OK);
 
 			Vector<uint8_t> file;
 			ERR_FAIL_COND(ECMAScriptLanguage::get_singleton()->get_main_binder()->compile_to_bytecode(code, p_path, file) != OK);
-			add_file(p_path.get_basename() + "." + extension + "b", file, true);
+			add_file(p_path.get_basename() + "." + extension + "b", make_bytecode_file(file), true);
 		}
 	}
 };
@@ -130,6 +348,8 @@ void register_ECMAScript_types() {
 
 	ClassDB::register_class<ECMAScript>();
 	ClassDB::register_class<ECMAScriptModule>();
+	ClassDB::register_virtual_class<QuickJSTransferredBuffer>();
+	ClassDB::register_virtual_class<QuickJSTransferredView>();
 
 	resource_loader_ecmascript.instance();
 	resource_saver_ecmascript.instance();
@@ -140,6 +360,7 @@ void register_ECMAScript_types() {
 	resource_saver_ecmascript_module.instance();
 	ResourceLoader::add_resource_format_loader(resource_loader_ecmascript_module, true);
 	ResourceSaver::add_resource_format_saver(resource_saver_ecmascript_module, true);
+	ResourceFormatLoaderECMAScriptModule::load_bundle();
 
 	script_language_js = memnew(ECMAScriptLanguage);
 	script_language_js->set_language_index(ScriptServer::get_language_count());
@@ -163,10 +384,13 @@ void unregister_ECMAScript_types() {
 	ResourceSaver::remove_resource_format_saver(resource_saver_ecmascript_module);
 	resource_loader_ecmascript_module.unref();
 	resource_saver_ecmascript_module.unref();
+	ResourceFormatLoaderECMAScriptModule::unload_bundle();
 }
 
 #ifdef TOOLS_ENABLED
 void editor_init_callback() {
+	GLOBAL_DEF("JavaScript/export/bundle_modules", false);
+
 	ECMAScriptPlugin *plugin = memnew(ECMAScriptPlugin(EditorNode::get_singleton()));
 	EditorNode::get_singleton()->add_editor_plugin(plugin);
 
@@ -1,6 +1,8 @@
 #include "editor_tools.h"
 #include "../ecmascript_language.h"
+#include "../quickjs/quickjs_module_resolver.h"
 #include "core/math/expression.h"
+#include "editor/editor_file_system.h"
 #include "editor/filesystem_dock.h"
 
 #define TS_IGNORE "//@ts-ignore\n"
@@ -30,10 +32,29 @@ void ECMAScriptPlugin::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_on_menu_item_pressed"), &ECMAScriptPlugin::_on_menu_item_pressed);
 	ClassDB::bind_method(D_METHOD("_export_typescript_declare_file"), &ECMAScriptPlugin::_export_typescript_declare_file);
 	ClassDB::bind_method(D_METHOD("_export_enumeration_binding_file"), &ECMAScriptPlugin::_export_enumeration_binding_file);
+	ClassDB::bind_method(D_METHOD("_on_filesystem_changed"), &ECMAScriptPlugin::_on_filesystem_changed);
+	ClassDB::bind_method(D_METHOD("_on_file_removed", "file"), &ECMAScriptPlugin::_on_file_removed);
+	ClassDB::bind_method(D_METHOD("_on_file_moved", "old_file", "new_file"), &ECMAScriptPlugin::_on_file_moved);
 }
 
 void ECMAScriptPlugin::_notification(int p_what) {
 	switch (p_what) {
+		case NOTIFICATION_ENTER_TREE: {
+			EditorFileSystem::get_singleton()->connect("filesystem_changed", this, "_on_filesystem_changed");
+			FileSystemDock *dock = EditorNode::get_singleton()->get_filesystem_dock();
+			dock->connect("file_removed", this, "_on_file_removed");
+			dock->connect("folder_removed", this, "_on_file_removed");
+			dock->connect("files_moved", this, "_on_file_moved");
+			dock->connect("folder_moved", this, "_on_file_moved");
+		} break;
+		case NOTIFICATION_EXIT_TREE: {
+			EditorFileSystem::get_singleton()->disconnect("filesystem_changed", this, "_on_filesystem_changed");
+			FileSystemDock *dock = EditorNode::get_singleton()->get_filesystem_dock();
+			dock->disconnect("file_removed", this, "_on_file_removed");
+			dock->disconnect("folder_removed", this, "_on_file_removed");
+			dock->disconnect("files_moved", this, "_on_file_moved");
+			dock->disconnect("folder_moved", this, "_on_file_moved");
+		} break;
 		case MainLoop::NOTIFICATION_WM_FOCUS_IN: {
 			Set<Ref<ECMAScript> > &scripts = ECMAScriptLanguage::get_singleton()->get_scripts();
 			for (Set<Ref<ECMAScript> >::Element *E = scripts.front(); E; E = E->next()) {
@@ -47,6 +68,19 @@ void ECMAScriptPlugin::_notification(int p_what) {
 	}
 }
 
+// Module resolution results depend on the project files, so any change drops them
+void ECMAScriptPlugin::_on_filesystem_changed() {
+	QuickJSModuleResolver::invalidate();
+}
+
+void ECMAScriptPlugin::_on_file_removed(const String &p_file) {
+	QuickJSModuleResolver::invalidate();
+}
+
+void ECMAScriptPlugin::_on_file_moved(const String &p_old_file, const String &p_new_file) {
+	QuickJSModuleResolver::invalidate();
+}
+
 void ECMAScriptPlugin::_on_menu_item_pressed(int item) {
 	switch (item) {
 		case MenuItem::ITEM_GEN_DECLAR_FILE:
@@ -551,6 +585,8 @@ void ECMAScriptPlugin::_export_typescript_declare_file(const String &p_path) {
 	ignored_classes.insert("Semaphore");
 	ignored_classes.insert("Thread");
 	ignored_classes.insert("Mutex");
+	ignored_classes.insert("QuickJSTransferredBuffer");
+	ignored_classes.insert("QuickJSTransferredView");
 
 	String classes = "";
 	String constants = "";